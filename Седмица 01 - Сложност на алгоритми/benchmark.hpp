@@ -0,0 +1,72 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class Pattern {
+  SORTED,
+  REVERSED,
+  ORGAN_PIPE,
+  ALL_EQUAL,
+  RANDOM
+};
+
+constexpr Pattern PATTERNS[] = {
+  Pattern::SORTED, Pattern::REVERSED, Pattern::ORGAN_PIPE, Pattern::ALL_EQUAL, Pattern::RANDOM
+};
+
+inline std::string pattern_name(Pattern pattern) {
+  switch (pattern) {
+    case Pattern::SORTED: return "sorted";
+    case Pattern::REVERSED: return "reversed";
+    case Pattern::ORGAN_PIPE: return "organ-pipe";
+    case Pattern::ALL_EQUAL: return "all-equal";
+    case Pattern::RANDOM: return "random";
+    default: return "";
+  }
+}
+
+inline std::vector<int> generate(Pattern pattern, std::size_t size, unsigned seed = 42) {
+  std::vector<int> result(size);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    switch (pattern) {
+      case Pattern::SORTED: result[i] = i; break;
+      case Pattern::REVERSED: result[i] = size - i; break;
+      case Pattern::ORGAN_PIPE: result[i] = i < size / 2 ? i : size - i; break;
+      case Pattern::ALL_EQUAL: result[i] = 42; break;
+      case Pattern::RANDOM: break;
+    }
+  }
+
+  if (pattern == Pattern::RANDOM) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution;
+    std::generate(result.begin(), result.end(), [&]() { return distribution(generator); });
+  }
+
+  return result;
+}
+
+// runs the sort on a fresh copy of the input and returns the elapsed milliseconds
+template <typename T, typename Sort>
+double measure(const std::vector<T>& input, Sort sort, bool* sorted = nullptr) {
+  std::vector<T> data = input;
+
+  auto start = std::chrono::steady_clock::now();
+  sort(data.data(), data.data() + data.size());
+  auto finish = std::chrono::steady_clock::now();
+
+  if (sorted) {
+    *sorted = std::is_sorted(data.begin(), data.end());
+  }
+
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef BLOCK_PARTITION_HPP
+#define BLOCK_PARTITION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// BlockQuicksort (Edelkamp, Weiss): the positions of misplaced elements are
+// collected into small offset buffers without branching and then swapped in batches
+
+constexpr std::ptrdiff_t PARTITION_BLOCK_SIZE = 128;
+
+#ifdef __AVX2__
+// for every 8 bit mask - the indices of its set bits packed as bytes
+constexpr std::array<std::uint64_t, 256> make_compress_table(bool reversed) {
+  std::array<std::uint64_t, 256> table{};
+
+  for (unsigned mask = 0; mask < 256; ++mask) {
+    unsigned count = 0;
+    for (unsigned bit = 0; bit < 8; ++bit) {
+      if (mask & (1u << bit)) {
+        std::uint64_t index = reversed ? 7 - bit : bit;
+        table[mask] |= index << (8 * count++);
+      }
+    }
+  }
+
+  return table;
+}
+
+constexpr std::array<std::uint64_t, 256> COMPRESS_TABLE = make_compress_table(false);
+constexpr std::array<std::uint64_t, 256> REVERSED_COMPRESS_TABLE = make_compress_table(true);
+
+// emulates a compress-store: writes the offsets of the set bits and returns their count
+inline unsigned compress_offsets(unsigned char* offsets, unsigned mask, unsigned base, bool reversed) {
+  std::uint64_t packed = (reversed ? REVERSED_COMPRESS_TABLE : COMPRESS_TABLE)[mask];
+  packed += base * 0x0101010101010101ull;
+  std::memcpy(offsets, &packed, sizeof(packed));
+
+  return __builtin_popcount(mask);
+}
+
+// 8 bit mask of the lanes in [data, data + 8) that are less than pivot
+inline unsigned less_mask(const int* data, int pivot) {
+  __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  __m256i less = _mm256_cmpgt_epi32(_mm256_set1_epi32(pivot), values);
+  return _mm256_movemask_ps(_mm256_castsi256_ps(less));
+}
+
+inline unsigned less_mask(const float* data, float pivot) {
+  __m256 values = _mm256_loadu_ps(data);
+  return _mm256_movemask_ps(_mm256_cmp_ps(values, _mm256_set1_ps(pivot), _CMP_LT_OQ));
+}
+
+template <typename T>
+constexpr bool has_simd_partition = std::is_same_v<T, int> || std::is_same_v<T, float>;
+#endif
+
+template <typename T>
+unsigned fill_left_offsets(const T* block, const T& pivot, unsigned char* offsets) {
+  unsigned count = 0;
+
+#ifdef __AVX2__
+  if constexpr (has_simd_partition<T>) {
+    for (unsigned i = 0; i < PARTITION_BLOCK_SIZE; i += 8) {
+      unsigned mask = ~less_mask(block + i, pivot) & 0xFF;
+      count += compress_offsets(offsets + count, mask, i, false);
+    }
+
+    return count;
+  }
+#endif
+
+  for (unsigned i = 0; i < PARTITION_BLOCK_SIZE; ++i) {
+    offsets[count] = i;
+    count += !(block[i] < pivot);
+  }
+
+  return count;
+}
+
+// offsets are counted backwards from block_end - 1
+template <typename T>
+unsigned fill_right_offsets(const T* block_end, const T& pivot, unsigned char* offsets) {
+  unsigned count = 0;
+
+#ifdef __AVX2__
+  if constexpr (has_simd_partition<T>) {
+    for (unsigned i = 0; i < PARTITION_BLOCK_SIZE; i += 8) {
+      unsigned mask = less_mask(block_end - i - 8, pivot);
+      count += compress_offsets(offsets + count, mask, i, true);
+    }
+
+    return count;
+  }
+#endif
+
+  for (unsigned i = 0; i < PARTITION_BLOCK_SIZE; ++i) {
+    offsets[count] = i;
+    count += *(block_end - 1 - i) < pivot;
+  }
+
+  return count;
+}
+
+// same contract as partition - the elements less than pivot go before the returned pointer
+template <typename T>
+T* block_partition(T* begin, T* end, const T& pivot) {
+  static_assert(std::is_arithmetic_v<T>, "block_partition works on arithmetic types only");
+
+  const T pivot_value = pivot;
+  // the SIMD path writes up to 8 bytes past the last offset
+  unsigned char offsets_left[PARTITION_BLOCK_SIZE + 8], offsets_right[PARTITION_BLOCK_SIZE + 8];
+  unsigned start_left = 0, start_right = 0, count_left = 0, count_right = 0;
+
+  while (end - begin > 2 * PARTITION_BLOCK_SIZE) {
+    if (count_left == 0) {
+      start_left = 0;
+      count_left = fill_left_offsets(begin, pivot_value, offsets_left);
+    }
+
+    if (count_right == 0) {
+      start_right = 0;
+      count_right = fill_right_offsets(end, pivot_value, offsets_right);
+    }
+
+    unsigned count = std::min(count_left, count_right);
+    for (unsigned i = 0; i < count; ++i) {
+      std::iter_swap(
+        begin + offsets_left[start_left + i],
+        end - 1 - offsets_right[start_right + i]
+      );
+    }
+
+    count_left -= count;
+    count_right -= count;
+    start_left += count;
+    start_right += count;
+
+    if (count_left == 0) {
+      begin += PARTITION_BLOCK_SIZE;
+    }
+
+    if (count_right == 0) {
+      end -= PARTITION_BLOCK_SIZE;
+    }
+  }
+
+  // everything before begin is less than the pivot and everything from end on is not,
+  // so whatever is left (including a half processed block) is partitioned element by element
+  while (begin != end) {
+    if (*begin < pivot_value) {
+      ++begin;
+    } else {
+      std::iter_swap(begin, end - 1);
+      --end;
+    }
+  }
+
+  return begin;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef PARALLEL_SORT_HPP
+#define PARALLEL_SORT_HPP
+
+#include "sorting.hpp"
+#include "thread_pool.hpp"
+#include <cstddef>
+
+// below this size a subrange is sorted sequentially by the task that owns it
+constexpr std::ptrdiff_t PARALLEL_SORT_CUTOFF = 1 << 15;
+
+// Pool is anything with spawn(TaskGroup&, task) and wait(TaskGroup&), like ThreadPool
+template <typename T, typename Pool>
+void parallel_quick_sort(T* begin, T* end, unsigned depth, Pool& pool, TaskGroup& group) {
+  while (end - begin > PARALLEL_SORT_CUTOFF) {
+    if (depth == 0) {
+      heap_sort(begin, end);
+      return;
+    }
+    --depth;
+
+    T *left_end, *right_begin;
+    pivot_partition(begin, end, left_end, right_begin);
+
+    // hand the smaller side to the pool, keep splitting the larger one
+    if (left_end - begin < end - right_begin) {
+      pool.spawn(group, [=, &pool, &group]() {
+        parallel_quick_sort(begin, left_end, depth, pool, group);
+      });
+      begin = right_begin;
+    } else {
+      pool.spawn(group, [=, &pool, &group]() {
+        parallel_quick_sort(right_begin, end, depth, pool, group);
+      });
+      end = left_end;
+    }
+  }
+
+  intro_sort(begin, end, depth);
+}
+
+template <typename T, typename Pool>
+void parallel_quick_sort(T* begin, T* end, Pool& pool) {
+  TaskGroup group;
+  parallel_quick_sort(begin, end, depth_limit(end - begin), pool, group);
+  pool.wait(group);
+}
+
+#endif
@@ -0,0 +1,40 @@
+#include "benchmark.hpp"
+#include "parallel_sort.hpp"
+#include "thread_pool.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// usage: parallel_sort_benchmark [size]
+int main(int argc, char* argv[]) {
+  std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::vector<int> input = generate(Pattern::RANDOM, size);
+
+  double sequential = measure(input, [](int* begin, int* end) { quick_sort(begin, end); });
+  std::cout << "quick_sort, " << size << " random ints: "
+            << std::fixed << std::setprecision(2) << sequential << "ms\n";
+
+  std::cout << std::setw(8) << "threads"
+            << std::setw(14) << "time"
+            << std::setw(10) << "speedup"
+            << std::setw(10) << "steals" << '\n';
+
+  for (unsigned threads : {1, 2, 4, 8, 16, 32}) {
+    ThreadPool pool(threads);
+    bool sorted = true;
+
+    double time = measure(input, [&pool](int* begin, int* end) {
+      parallel_quick_sort(begin, end, pool);
+    }, &sorted);
+
+    std::cout << std::setw(8) << threads
+              << std::setw(12) << time << "ms"
+              << std::setw(9) << sequential / time << 'x'
+              << std::setw(10) << pool.steal_count()
+              << (sorted ? "" : "  NOT SORTED") << '\n';
+  }
+
+  return 0;
+}
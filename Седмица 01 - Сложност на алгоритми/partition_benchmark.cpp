@@ -0,0 +1,66 @@
+#include "benchmark.hpp"
+#include "sorting.hpp"
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// partitions the same random input around the median many times
+template <typename T, typename Partition>
+double measure_partition(const std::vector<T>& input, Partition partition_function, unsigned repetitions) {
+  std::vector<T> data;
+  T pivot = input[input.size() / 2];
+  double total = 0;
+
+  for (unsigned i = 0; i < repetitions; ++i) {
+    data = input;
+
+    auto start = std::chrono::steady_clock::now();
+    partition_function(data.data(), data.data() + data.size(), pivot);
+    auto finish = std::chrono::steady_clock::now();
+
+    total += std::chrono::duration<double, std::milli>(finish - start).count();
+  }
+
+  return total / repetitions;
+}
+
+template <typename T>
+void run(const std::string& type_name, const std::vector<int>& keys) {
+  std::vector<T> input(keys.begin(), keys.end());
+
+  double scalar = measure_partition(input, [](T* begin, T* end, const T& pivot) {
+    return partition(begin, end, pivot);
+  }, 20);
+  double block = measure_partition(input, [](T* begin, T* end, const T& pivot) {
+    return block_partition(begin, end, pivot);
+  }, 20);
+  double sort = measure(input, [](T* begin, T* end) { quick_sort(begin, end); });
+
+  std::cout << std::setw(8) << type_name
+            << std::setw(12) << std::fixed << std::setprecision(2) << scalar << "ms"
+            << std::setw(12) << block << "ms"
+            << std::setw(12) << sort << "ms" << '\n';
+}
+
+int main() {
+  constexpr std::size_t SIZE = 10000000;
+  std::vector<int> keys = generate(Pattern::RANDOM, SIZE);
+
+#ifdef __AVX2__
+  std::cout << "AVX2 offsets enabled\n";
+#endif
+  std::cout << std::setw(8) << "type"
+            << std::setw(14) << "partition"
+            << std::setw(14) << "block"
+            << std::setw(14) << "quick_sort" << '\n';
+
+  run<int>("int", keys);
+  run<float>("float", keys);
+  run<double>("double", keys);
+  run<long long>("int64", keys);
+
+  return 0;
+}
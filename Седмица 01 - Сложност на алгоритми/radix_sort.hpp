@@ -0,0 +1,100 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+constexpr unsigned RADIX_BITS = 8;
+constexpr std::size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+
+template <std::size_t Size> struct UnsignedOfSize;
+template <> struct UnsignedOfSize<1> { using type = std::uint8_t; };
+template <> struct UnsignedOfSize<2> { using type = std::uint16_t; };
+template <> struct UnsignedOfSize<4> { using type = std::uint32_t; };
+template <> struct UnsignedOfSize<8> { using type = std::uint64_t; };
+
+// integers up to 64 bits, float and double
+template <typename T>
+constexpr bool is_radix_sortable =
+  (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8) ||
+  std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <typename T>
+using RadixKey = typename UnsignedOfSize<sizeof(T)>::type;
+
+// maps the value to an unsigned key with the same order: signed integers get their
+// sign bit flipped, negative floats get all of their bits flipped
+template <typename T>
+RadixKey<T> radix_key(T value) {
+  using Key = RadixKey<T>;
+  constexpr Key SIGN_BIT = Key(1) << (8 * sizeof(T) - 1);
+
+  Key key;
+  std::memcpy(&key, &value, sizeof(T));
+
+  if constexpr (std::is_floating_point_v<T>) {
+    return key & SIGN_BIT ? Key(~key) : Key(key | SIGN_BIT);
+  } else if constexpr (std::is_signed_v<T>) {
+    return key ^ SIGN_BIT;
+  } else {
+    return key;
+  }
+}
+
+// LSD radix sort with 8 bit digits; all the histograms are built in a single pass
+// and the digits on which every element falls into the same bucket are skipped
+template <typename T>
+void radix_sort(T* begin, T* end) {
+  static_assert(is_radix_sortable<T>, "radix_sort works on integers, float and double");
+
+  constexpr std::size_t DIGITS = sizeof(T) * 8 / RADIX_BITS;
+  std::size_t size = end - begin;
+  if (size < 2) {
+    return;
+  }
+
+  std::vector<std::size_t> histograms(DIGITS * RADIX_BUCKETS, 0);
+  for (T* iter = begin; iter != end; ++iter) {
+    RadixKey<T> key = radix_key(*iter);
+
+    for (std::size_t digit = 0; digit < DIGITS; ++digit) {
+      ++histograms[digit * RADIX_BUCKETS + ((key >> (digit * RADIX_BITS)) & (RADIX_BUCKETS - 1))];
+    }
+  }
+
+  std::vector<T> buffer(size);
+  T *from = begin, *to = buffer.data();
+
+  for (std::size_t digit = 0; digit < DIGITS; ++digit) {
+    std::size_t* histogram = histograms.data() + digit * RADIX_BUCKETS;
+    unsigned shift = digit * RADIX_BITS;
+
+    if (histogram[(radix_key(*from) >> shift) & (RADIX_BUCKETS - 1)] == size) {
+      continue;
+    }
+
+    // turn the counts into starting offsets
+    std::size_t offset = 0;
+    for (std::size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+      std::size_t count = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += count;
+    }
+
+    for (std::size_t i = 0; i < size; ++i) {
+      to[histogram[(radix_key(from[i]) >> shift) & (RADIX_BUCKETS - 1)]++] = from[i];
+    }
+
+    std::swap(from, to);
+  }
+
+  if (from != begin) {
+    std::copy(from, from + size, begin);
+  }
+}
+
+#endif
@@ -0,0 +1,48 @@
+#include "benchmark.hpp"
+#include "radix_sort.hpp"
+#include "sorting.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+template <typename T>
+void run(const std::string& type_name, std::size_t size) {
+  std::vector<int> keys = generate(Pattern::RANDOM, size);
+  std::vector<T> input(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    // spread the keys over negative values too
+    input[i] = T(keys[i]) - T(keys[size - i - 1]);
+  }
+
+  bool sorted = true;
+  double radix = measure(input, [](T* begin, T* end) { radix_sort(begin, end); }, &sorted);
+  double quick = measure(input, [](T* begin, T* end) { quick_sort(begin, end); });
+  double dispatched = measure(input, [](T* begin, T* end) { sort(begin, end); });
+
+  std::cout << std::setw(8) << type_name
+            << std::setw(10) << size
+            << std::setw(12) << std::fixed << std::setprecision(3) << radix << "ms"
+            << std::setw(12) << quick << "ms"
+            << std::setw(12) << dispatched << "ms"
+            << (sorted ? "" : "  NOT SORTED") << '\n';
+}
+
+int main() {
+  std::cout << std::setw(8) << "type"
+            << std::setw(10) << "size"
+            << std::setw(14) << "radix_sort"
+            << std::setw(14) << "quick_sort"
+            << std::setw(14) << "sort" << '\n';
+
+  for (std::size_t size : {256, 2048, 65536, 1000000, 10000000}) {
+    run<int>("int", size);
+    run<float>("float", size);
+    run<double>("double", size);
+    run<std::int64_t>("int64", size);
+  }
+
+  return 0;
+}
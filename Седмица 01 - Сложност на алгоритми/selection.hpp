@@ -0,0 +1,123 @@
+#ifndef SELECTION_HPP
+#define SELECTION_HPP
+
+#include "sorting.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Introselect: quickselect with the same pivots as intro_sort; once the depth
+// limit runs out the pivots are chosen by median of medians, which guarantees
+// that every step discards at least 30% of the range - linear in the worst case.
+
+template <typename T>
+void nth_element(T* begin, T* nth, T* end);
+
+// moves the median of the medians of groups of 5 to *begin
+template <typename T>
+void median_of_medians(T* begin, T* end) {
+  std::ptrdiff_t size = end - begin, medians = 0;
+
+  for (std::ptrdiff_t group = 0; group < size; group += 5) {
+    std::ptrdiff_t group_size = std::min<std::ptrdiff_t>(5, size - group);
+    insertion_sort(begin + group, begin + group + group_size);
+    std::iter_swap(begin + medians++, begin + group + group_size / 2);
+  }
+
+  nth_element(begin, begin + medians / 2, begin + medians);
+  std::iter_swap(begin, begin + medians / 2);
+}
+
+template <typename T>
+void select_partition(T* begin, T* end, unsigned& depth, T*& left_end, T*& right_begin) {
+  if (depth == 0) {
+    median_of_medians(begin, end);
+    partition_around_first(begin, end, left_end, right_begin);
+  } else {
+    --depth;
+    pivot_partition(begin, end, left_end, right_begin);
+  }
+}
+
+// rearranges the range so that *nth is the element that would be there if it was
+// sorted, with nothing greater before it and nothing less after it
+template <typename T>
+void nth_element(T* begin, T* nth, T* end) {
+  unsigned depth = depth_limit(end - begin);
+
+  while (end - begin > INSERTION_SORT_THRESHOLD) {
+    T *left_end, *right_begin;
+    select_partition(begin, end, depth, left_end, right_begin);
+
+    if (nth < left_end) {
+      end = left_end;
+    } else if (nth >= right_begin) {
+      begin = right_begin;
+    } else {
+      return;
+    }
+  }
+
+  insertion_sort(begin, end);
+}
+
+// sorts the smallest middle - begin elements into [begin, middle)
+template <typename T>
+void partial_sort(T* begin, T* middle, T* end) {
+  if (middle == begin) {
+    return;
+  }
+
+  if (middle != end) {
+    nth_element(begin, middle, end);
+  }
+  quick_sort(begin, middle);
+}
+
+// [nths_begin, nths_end) are sorted positions inside [begin, end)
+template <typename T>
+void multi_select(T* begin, T* end, T* const* nths_begin, T* const* nths_end, unsigned depth) {
+  while (nths_begin != nths_end) {
+    if (end - begin <= INSERTION_SORT_THRESHOLD) {
+      insertion_sort(begin, end);
+      return;
+    }
+
+    T *left_end, *right_begin;
+    select_partition(begin, end, depth, left_end, right_begin);
+
+    // the positions left of the pivot block, inside it (already in place) and right of it
+    T* const* left_nths = std::lower_bound(nths_begin, nths_end, left_end);
+    T* const* right_nths = std::lower_bound(left_nths, nths_end, right_begin);
+
+    // recurse on the side with fewer positions, loop on the other one
+    if (left_nths - nths_begin < nths_end - right_nths) {
+      multi_select(begin, left_end, nths_begin, left_nths, depth);
+      begin = right_begin;
+      nths_begin = right_nths;
+    } else {
+      multi_select(right_begin, end, right_nths, nths_end, depth);
+      end = left_end;
+      nths_end = left_nths;
+    }
+  }
+}
+
+// places the elements of all the given ranks (0-based) in their sorted positions
+// by a single partitioning pass that splits only the subranges still holding a rank
+template <typename T>
+void multi_select(T* begin, T* end, const std::vector<std::size_t>& ranks) {
+  std::vector<T*> nths;
+  for (std::size_t rank : ranks) {
+    if (rank < static_cast<std::size_t>(end - begin)) {
+      nths.push_back(begin + rank);
+    }
+  }
+
+  std::sort(nths.begin(), nths.end());
+  nths.erase(std::unique(nths.begin(), nths.end()), nths.end());
+
+  multi_select(begin, end, nths.data(), nths.data() + nths.size(), depth_limit(end - begin));
+}
+
+#endif
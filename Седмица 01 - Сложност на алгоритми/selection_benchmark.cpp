@@ -0,0 +1,54 @@
+#include "benchmark.hpp"
+#include "selection.hpp"
+#include "sorting.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void report(const std::string& name, double time, double full_sort) {
+  std::cout << std::setw(28) << name
+            << std::setw(12) << std::fixed << std::setprecision(2) << time << "ms"
+            << std::setw(9) << full_sort / time << "x faster than sort\n";
+}
+
+// usage: selection_benchmark [size]
+int main(int argc, char* argv[]) {
+  std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::vector<int> input = generate(Pattern::RANDOM, size);
+
+  double full_sort = measure(input, [](int* begin, int* end) { quick_sort(begin, end); });
+  std::cout << "quick_sort of " << size << " random ints: "
+            << std::fixed << std::setprecision(2) << full_sort << "ms\n";
+
+  for (std::size_t k : {std::size_t(10), size / 100, size / 2}) {
+    std::string suffix = " k = " + std::to_string(k);
+
+    report("nth_element" + suffix, measure(input, [k](int* begin, int* end) {
+      nth_element(begin, begin + k, end);
+    }), full_sort);
+
+    report("partial_sort" + suffix, measure(input, [k](int* begin, int* end) {
+      partial_sort(begin, begin + k, end);
+    }), full_sort);
+  }
+
+  std::vector<std::size_t> percentiles;
+  for (double percentile : {0.5, 0.9, 0.95, 0.99, 0.999}) {
+    percentiles.push_back(static_cast<std::size_t>(percentile * (size - 1)));
+  }
+
+  report("multi_select p50..p99.9", measure(input, [&percentiles](int* begin, int* end) {
+    multi_select(begin, end, percentiles);
+  }), full_sort);
+
+  report("nth_element x5 p50..p99.9", measure(input, [&percentiles](int* begin, int* end) {
+    for (std::size_t rank : percentiles) {
+      nth_element(begin, begin + rank, end);
+    }
+  }), full_sort);
+
+  return 0;
+}
@@ -0,0 +1,35 @@
+#include "benchmark.hpp"
+#include "sorting.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+
+int main() {
+  constexpr std::size_t SIZE = 1000000;
+  // the recursion depth of simple_quick_sort is linear on these, so keep them small
+  constexpr std::size_t SIMPLE_SIZE = 20000;
+
+  std::cout << std::setw(12) << "pattern"
+            << std::setw(14) << "intro_sort"
+            << std::setw(14) << "std::sort"
+            << std::setw(14) << "simple (20k)" << '\n';
+
+  for (Pattern pattern : PATTERNS) {
+    std::vector<int> input = generate(pattern, SIZE);
+    std::vector<int> small_input = generate(pattern, SIMPLE_SIZE);
+    bool sorted = true;
+
+    double intro = measure(input, [](int* begin, int* end) { intro_sort(begin, end); }, &sorted);
+    double standard = measure(input, [](int* begin, int* end) { std::sort(begin, end); });
+    double simple = measure(small_input, [](int* begin, int* end) { simple_quick_sort(begin, end); });
+
+    std::cout << std::setw(12) << pattern_name(pattern)
+              << std::setw(12) << std::fixed << std::setprecision(2) << intro << "ms"
+              << std::setw(12) << standard << "ms"
+              << std::setw(12) << simple << "ms"
+              << (sorted ? "" : "  NOT SORTED") << '\n';
+  }
+
+  return 0;
+}
@@ -0,0 +1,249 @@
+#ifndef SORTING_HPP
+#define SORTING_HPP
+
+#include "block_partition.hpp"
+#include "radix_sort.hpp"
+#include "sorting_network.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+constexpr std::ptrdiff_t INSERTION_SORT_THRESHOLD = 24;
+constexpr std::ptrdiff_t NINTHER_THRESHOLD = 128;
+// arithmetic base cases are sorted by the branch-free sorting networks
+template <typename T>
+constexpr std::ptrdiff_t SMALL_SORT_THRESHOLD =
+  std::is_arithmetic_v<T> ? std::ptrdiff_t(MAX_NETWORK_SIZE) : INSERTION_SORT_THRESHOLD;
+// smaller arithmetic ranges are sorted by comparisons
+constexpr std::ptrdiff_t RADIX_SORT_THRESHOLD = 1 << 11;
+
+template <typename T>
+void insertion_sort(T* begin, T* end) {
+  if (end - begin < 2) {
+    return;
+  }
+
+  T* iter = begin + 1;
+
+  while (iter != end) {
+    if (*(iter - 1) > *iter) {
+      T value = std::move(*iter);
+      T* hole = iter;
+
+      // shift the greater elements one position to the right
+      do {
+        *hole = std::move(*(hole - 1));
+        --hole;
+      } while (hole != begin && *(hole - 1) > value);
+
+      *hole = std::move(value);
+    }
+
+    ++iter;
+  }
+}
+
+template <typename T>
+void small_sort(T* begin, T* end) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (end - begin <= std::ptrdiff_t(MAX_NETWORK_SIZE)) {
+      network_sort(begin, end);
+      return;
+    }
+  }
+
+  insertion_sort(begin, end);
+}
+
+template <typename T>
+T* partition(T* begin, T* end, const T& pivot) {
+  while (begin != end) {
+    if (*begin < pivot) {
+      ++begin;
+    } else {
+      std::iter_swap(begin, end - 1);
+      --end;
+    }
+  }
+
+  return begin;
+}
+
+// integral and floating-point keys use the branch-free block partition
+template <typename T>
+T* fast_partition(T* begin, T* end, const T& pivot) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return block_partition(begin, end, pivot);
+  } else {
+    return partition(begin, end, pivot);
+  }
+}
+
+// moves the elements equal to pivot (given that none are smaller) to the front
+template <typename T>
+T* partition_equal(T* begin, T* end, const T& pivot) {
+  while (begin != end) {
+    if (!(pivot < *begin)) {
+      ++begin;
+    } else {
+      std::iter_swap(begin, end - 1);
+      --end;
+    }
+  }
+
+  return begin;
+}
+
+template <typename T>
+void simple_quick_sort(T* begin, T* end) {
+  if (end - begin <= 1) {
+    return;
+  }
+
+  T pivot = *begin;
+  T* middle = partition(begin + 1, end, pivot);
+  std::iter_swap(begin, middle - 1);
+  simple_quick_sort(begin, middle - 1);
+  simple_quick_sort(middle, end);
+}
+
+template <typename T>
+void sift_down(T* heap, std::ptrdiff_t index, std::ptrdiff_t size) {
+  while (2 * index + 1 < size) {
+    std::ptrdiff_t child = 2 * index + 1;
+
+    if (child + 1 < size && heap[child] < heap[child + 1]) {
+      ++child;
+    }
+
+    if (!(heap[index] < heap[child])) {
+      return;
+    }
+
+    std::iter_swap(heap + index, heap + child);
+    index = child;
+  }
+}
+
+template <typename T>
+void heap_sort(T* begin, T* end) {
+  std::ptrdiff_t size = end - begin;
+
+  for (std::ptrdiff_t i = size / 2 - 1; i >= 0; --i) {
+    sift_down(begin, i, size);
+  }
+
+  while (size > 1) {
+    std::iter_swap(begin, begin + --size);
+    sift_down(begin, 0, size);
+  }
+}
+
+// orders the three elements so that *b holds their median
+template <typename T>
+void sort3(T* a, T* b, T* c) {
+  if (*b < *a) std::iter_swap(a, b);
+  if (*c < *b) std::iter_swap(b, c);
+  if (*b < *a) std::iter_swap(a, b);
+}
+
+// median of three for small ranges, Tukey's ninther for large ones;
+// the chosen pivot ends up in *begin
+template <typename T>
+void choose_pivot(T* begin, T* end) {
+  std::ptrdiff_t size = end - begin;
+  T* middle = begin + size / 2;
+
+  if (size > NINTHER_THRESHOLD) {
+    sort3(begin, middle, end - 1);
+    sort3(begin + 1, middle - 1, end - 2);
+    sort3(begin + 2, middle + 1, end - 3);
+    sort3(middle - 1, middle, middle + 1);
+  } else {
+    sort3(begin, middle, end - 1);
+  }
+
+  std::iter_swap(begin, middle);
+}
+
+inline unsigned depth_limit(std::ptrdiff_t size) {
+  unsigned log = 0;
+  while (size > 1) {
+    size >>= 1;
+    ++log;
+  }
+
+  return 2 * log;
+}
+
+// partitions around the pivot in *begin: [begin, left_end) is less than it and
+// [right_begin, end) is not, everything in between is equal to the pivot
+template <typename T>
+void partition_around_first(T* begin, T* end, T*& left_end, T*& right_begin) {
+  T* middle = fast_partition(begin + 1, end, *begin);
+  std::iter_swap(begin, middle - 1);
+
+  left_end = middle - 1;
+  right_begin = middle;
+
+  // nothing is smaller than the pivot - skip all the elements equal to it
+  if (left_end == begin) {
+    right_begin = partition_equal(middle, end, *left_end);
+  }
+}
+
+template <typename T>
+void pivot_partition(T* begin, T* end, T*& left_end, T*& right_begin) {
+  choose_pivot(begin, end);
+  partition_around_first(begin, end, left_end, right_begin);
+}
+
+template <typename T>
+void intro_sort(T* begin, T* end, unsigned depth) {
+  while (end - begin > SMALL_SORT_THRESHOLD<T>) {
+    if (depth == 0) {
+      heap_sort(begin, end);
+      return;
+    }
+    --depth;
+
+    T *left_end, *right_begin;
+    pivot_partition(begin, end, left_end, right_begin);
+
+    // recurse on the smaller side, loop on the larger one
+    if (left_end - begin < end - right_begin) {
+      intro_sort(begin, left_end, depth);
+      begin = right_begin;
+    } else {
+      intro_sort(right_begin, end, depth);
+      end = left_end;
+    }
+  }
+
+  small_sort(begin, end);
+}
+
+template <typename T>
+void intro_sort(T* begin, T* end) {
+  intro_sort(begin, end, depth_limit(end - begin));
+}
+
+template <typename T>
+void quick_sort(T* begin, T* end) {
+  intro_sort(begin, end);
+}
+
+template <typename T>
+void sort(T* begin, T* end) {
+  if constexpr (is_radix_sortable<T>) {
+    if (end - begin >= RADIX_SORT_THRESHOLD) {
+      radix_sort(begin, end);
+      return;
+    }
+  }
+
+  quick_sort(begin, end);
+}
+
+#endif
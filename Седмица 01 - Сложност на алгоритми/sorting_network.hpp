@@ -0,0 +1,195 @@
+#ifndef SORTING_NETWORK_HPP
+#define SORTING_NETWORK_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Sorting networks for up to 16 elements. The comparators of Batcher's odd-even
+// merge sort are generated at compile time (for the next power of two, keeping
+// only the comparators inside the range) and the network is unrolled into a
+// straight sequence of min/max operations without any data-dependent branches.
+
+constexpr std::size_t MAX_NETWORK_SIZE = 16;
+// below this size transposing the groups into vectors costs more than the scalar network
+constexpr std::size_t MIN_SIMD_NETWORK_SIZE = 12;
+
+struct Comparator {
+  std::size_t first, second;
+};
+
+template <typename Visit>
+constexpr void for_each_comparator(std::size_t size, Visit visit) {
+  std::size_t padded = 1;
+  while (padded < size) {
+    padded <<= 1;
+  }
+
+  for (std::size_t p = 1; p < padded; p <<= 1) {
+    for (std::size_t k = p; k >= 1; k >>= 1) {
+      for (std::size_t j = k % p; j + k < padded; j += 2 * k) {
+        for (std::size_t i = 0; i < k && i + j + k < padded; ++i) {
+          std::size_t first = i + j, second = i + j + k;
+
+          if (first / (2 * p) == second / (2 * p) && second < size) {
+            visit(first, second);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <std::size_t N>
+constexpr std::size_t network_length() {
+  std::size_t length = 0;
+  for_each_comparator(N, [&length](std::size_t, std::size_t) { ++length; });
+  return length;
+}
+
+template <std::size_t N>
+constexpr std::array<Comparator, network_length<N>()> make_network() {
+  std::array<Comparator, network_length<N>()> network{};
+  std::size_t length = 0;
+
+  for_each_comparator(N, [&network, &length](std::size_t first, std::size_t second) {
+    network[length].first = first;
+    network[length].second = second;
+    ++length;
+  });
+
+  return network;
+}
+
+template <std::size_t N>
+constexpr auto NETWORK = make_network<N>();
+
+// Integers are compiled to min/max (cmov, ...) instead of a branch. Floating point takes the
+// branch: with a NaN the two selects below would disagree and copy one value over the other.
+template <typename T>
+void compare_exchange(T& a, T& b) {
+  if constexpr (std::is_integral_v<T>) {
+    // two independent selects - written with one condition the compiler folds them into a branch
+    T low = b < a ? b : a;
+    T high = a < b ? b : a;
+    a = low;
+    b = high;
+  } else if (b < a) {
+    std::swap(a, b);
+  }
+}
+
+#ifdef __AVX2__
+// eight lanes at once
+inline void compare_exchange(__m256i& a, __m256i& b) {
+  __m256i low = _mm256_min_epi32(a, b);
+  b = _mm256_max_epi32(a, b);
+  a = low;
+}
+
+// min_ps and max_ps both return b when a lane holds a NaN, so the lanes are swapped
+// on one mask instead - a pair with a NaN stays as it is, like the scalar version
+inline void compare_exchange(__m256& a, __m256& b) {
+  __m256 swap = _mm256_cmp_ps(b, a, _CMP_LT_OQ);
+  __m256 low = _mm256_blendv_ps(a, b, swap);
+  b = _mm256_blendv_ps(b, a, swap);
+  a = low;
+}
+#endif
+
+template <std::size_t N, typename T, std::size_t... I>
+void apply_network([[maybe_unused]] T* data, std::index_sequence<I...>) {
+  (compare_exchange(data[NETWORK<N>[I].first], data[NETWORK<N>[I].second]), ...);
+}
+
+template <std::size_t N, typename T>
+void network_sort(T* data) {
+  apply_network<N>(data, std::make_index_sequence<NETWORK<N>.size()>());
+}
+
+template <typename T, std::size_t... N>
+constexpr std::array<void (*)(T*), sizeof...(N)> make_network_table(std::index_sequence<N...>) {
+  return {&network_sort<N, T>...};
+}
+
+// sorts a range of at most MAX_NETWORK_SIZE elements with the network of its size
+template <typename T>
+void network_sort(T* begin, T* end) {
+  static constexpr auto TABLE = make_network_table<T>(std::make_index_sequence<MAX_NETWORK_SIZE + 1>());
+  TABLE[end - begin](begin);
+}
+
+#ifdef __AVX2__
+template <typename T>
+struct SimdVector;
+template <> struct SimdVector<int> { using type = __m256i; };
+template <> struct SimdVector<float> { using type = __m256; };
+
+// the elements data[0], data[stride], ..., data[7 * stride]
+inline __m256i gather_vector(const int* data, __m256i offsets) {
+  return _mm256_i32gather_epi32(data, offsets, sizeof(int));
+}
+
+inline __m256 gather_vector(const float* data, __m256i offsets) {
+  return _mm256_i32gather_ps(data, offsets, sizeof(float));
+}
+
+inline void store_vector(int* data, __m256i vector) {
+  _mm256_store_si256(reinterpret_cast<__m256i*>(data), vector);
+}
+
+inline void store_vector(float* data, __m256 vector) {
+  _mm256_store_ps(data, vector);
+}
+
+// sorts 8 groups at once - lane l of vector i holds element i of group l
+template <std::size_t N, typename T>
+void network_sort_8_groups(T* groups) {
+  alignas(32) T lanes[N][8];
+  typename SimdVector<T>::type vectors[N];
+  __m256i offsets = _mm256_setr_epi32(0, N, 2 * N, 3 * N, 4 * N, 5 * N, 6 * N, 7 * N);
+
+  for (std::size_t i = 0; i < N; ++i) {
+    vectors[i] = gather_vector(groups + i, offsets);
+  }
+
+  apply_network<N>(vectors, std::make_index_sequence<NETWORK<N>.size()>());
+
+  for (std::size_t i = 0; i < N; ++i) {
+    store_vector(lanes[i], vectors[i]);
+  }
+
+  for (std::size_t group = 0; group < 8; ++group) {
+    for (std::size_t i = 0; i < N; ++i) {
+      groups[group * N + i] = lanes[i][group];
+    }
+  }
+}
+#endif
+
+// sorts count consecutive groups of N elements each; larger int and float groups
+// are sorted 8 at a time with AVX2 min/max when available
+template <std::size_t N, typename T>
+void network_sort_groups(T* groups, std::size_t count) {
+  std::size_t group = 0;
+
+#ifdef __AVX2__
+  if constexpr ((std::is_same_v<T, int> || std::is_same_v<T, float>) && N >= MIN_SIMD_NETWORK_SIZE) {
+    for (; group + 8 <= count; group += 8) {
+      network_sort_8_groups<N>(groups + group * N);
+    }
+  }
+#endif
+
+  for (; group < count; ++group) {
+    network_sort<N>(groups + group * N);
+  }
+}
+
+#endif
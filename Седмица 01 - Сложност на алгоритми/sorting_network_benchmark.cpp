@@ -0,0 +1,68 @@
+#include "benchmark.hpp"
+#include "sorting.hpp"
+#include "sorting_network.hpp"
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+constexpr std::size_t GROUPS = 2000000;
+
+double million_groups_per_second(double ms) {
+  return GROUPS / ms / 1000.0;
+}
+
+// sorts GROUPS consecutive groups of N random keys in three ways
+template <std::size_t N, typename T>
+void run() {
+  std::vector<int> keys = generate(Pattern::RANDOM, N * GROUPS);
+  std::vector<T> input(keys.begin(), keys.end());
+
+  double insertion = measure(input, [](T* begin, T* end) {
+    for (; begin != end; begin += N) {
+      insertion_sort(begin, begin + N);
+    }
+  });
+
+  double network = measure(input, [](T* begin, T* end) {
+    for (; begin != end; begin += N) {
+      network_sort<N>(begin);
+    }
+  });
+
+  double batched = measure(input, [](T* begin, T* end) {
+    network_sort_groups<N>(begin, (end - begin) / N);
+  });
+
+  std::cout << std::setw(4) << N
+            << std::setw(7) << NETWORK<N>.size()
+            << std::setw(14) << std::fixed << std::setprecision(2) << million_groups_per_second(insertion)
+            << std::setw(14) << million_groups_per_second(network)
+            << std::setw(14) << million_groups_per_second(batched) << '\n';
+}
+
+template <typename T>
+void run_all(const char* type_name) {
+  std::cout << type_name << ", million groups per second\n"
+            << std::setw(4) << "N"
+            << std::setw(7) << "cmps"
+            << std::setw(14) << "insertion"
+            << std::setw(14) << "network"
+            << std::setw(14) << "batched" << '\n';
+
+  run<4, T>();
+  run<6, T>();
+  run<8, T>();
+  run<12, T>();
+  run<16, T>();
+}
+
+int main() {
+#ifdef __AVX2__
+  std::cout << "AVX2 batches enabled\n";
+#endif
+  run_all<int>("int");
+  run_all<float>("float");
+
+  return 0;
+}
@@ -0,0 +1,228 @@
+#ifndef STRING_SORT_HPP
+#define STRING_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+// String sorts that do not re-compare the shared prefixes of the strings. Within a subrange all the strings
+// share their first depth characters, so only the rest of them is inspected.
+// Strings are only ever moved or swapped (which swaps their buffers), never copied.
+
+constexpr std::ptrdiff_t STRING_INSERTION_SORT_THRESHOLD = 16;
+constexpr std::size_t ALPHABET_SIZE = 256;
+constexpr std::size_t KEY_CHARACTERS = 7;
+
+// the character at depth, or -1 past the end of the string, so shorter strings go first
+inline int char_at(const std::string& string, std::size_t depth) {
+  return depth < string.size() ? static_cast<unsigned char>(string[depth]) : -1;
+}
+
+// the next 7 characters from depth on packed with their count in the lowest byte;
+// comparing two keys compares these parts of the strings, with the shorter first,
+// so one pass over the strings inspects 7 characters instead of 1
+inline std::uint64_t key_at(const std::string& string, std::size_t depth) {
+  std::size_t count = depth < string.size() ? std::min(string.size() - depth, KEY_CHARACTERS) : 0;
+  std::uint64_t key = 0;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    key = key << 8 | static_cast<unsigned char>(string[depth + i]);
+  }
+
+  return key << 8 * (KEY_CHARACTERS - count) << 8 | count;
+}
+
+// the strings with this key end within it
+inline bool key_ends(std::uint64_t key) {
+  return (key & 0xFF) < KEY_CHARACTERS;
+}
+
+inline bool less_from(const std::string& a, const std::string& b, std::size_t depth) {
+  return a.compare(depth, std::string::npos, b, depth, std::string::npos) < 0;
+}
+
+inline void string_insertion_sort(std::string* begin, std::string* end, std::size_t depth) {
+  for (std::string* iter = begin + 1; iter < end; ++iter) {
+    if (!less_from(*iter, *(iter - 1), depth)) {
+      continue;
+    }
+
+    std::string value = std::move(*iter);
+    std::string* hole = iter;
+
+    do {
+      *hole = std::move(*(hole - 1));
+      --hole;
+    } while (hole != begin && less_from(value, *(hole - 1), depth));
+
+    *hole = std::move(value);
+  }
+}
+
+// a string together with its cached key at the current depth
+struct StringKey {
+  std::uint64_t key;
+  std::string* string;
+};
+
+inline bool less_from(const StringKey& a, const StringKey& b, std::size_t depth) {
+  if (a.key != b.key) {
+    return a.key < b.key;
+  }
+
+  return !key_ends(a.key) && less_from(*a.string, *b.string, depth + KEY_CHARACTERS);
+}
+
+// the keys are valid for depth
+inline void string_key_insertion_sort(StringKey* begin, StringKey* end, std::size_t depth) {
+  for (StringKey* iter = begin + 1; iter < end; ++iter) {
+    StringKey value = *iter;
+    StringKey* hole = iter;
+
+    while (hole != begin && less_from(value, *(hole - 1), depth)) {
+      *hole = *(hole - 1);
+      --hole;
+    }
+
+    *hole = value;
+  }
+}
+
+// Bentley-Sedgewick three-way radix quicksort over (key, pointer) pairs: partitions
+// by the key at depth into less, equal and greater parts, and only the equal part moves
+// on to the next key. The keys are read from the strings once per depth and the
+// partitioning itself works on the small contiguous pairs.
+inline void multikey_quick_sort(StringKey* begin, StringKey* end, std::size_t depth, bool keys_ready) {
+  while (end - begin > STRING_INSERTION_SORT_THRESHOLD) {
+    if (!keys_ready) {
+      for (StringKey* iter = begin; iter != end; ++iter) {
+        iter->key = key_at(*iter->string, depth);
+      }
+    }
+
+    std::uint64_t a = begin->key, b = begin[(end - begin) / 2].key, c = (end - 1)->key;
+    std::uint64_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+    StringKey *less_end = begin, *iter = begin, *greater_begin = end;
+    while (iter < greater_begin) {
+      if (iter->key < pivot) {
+        std::swap(*less_end++, *iter++);
+      } else if (iter->key > pivot) {
+        std::swap(*iter, *--greater_begin);
+      } else {
+        ++iter;
+      }
+    }
+
+    multikey_quick_sort(begin, less_end, depth, true);
+    multikey_quick_sort(greater_begin, end, depth, true);
+
+    // the equal strings have all ended - nothing left to compare
+    if (key_ends(pivot)) {
+      return;
+    }
+
+    begin = less_end;
+    end = greater_begin;
+    depth += KEY_CHARACTERS;
+    keys_ready = false;
+  }
+
+  if (!keys_ready) {
+    for (StringKey* iter = begin; iter != end; ++iter) {
+      iter->key = key_at(*iter->string, depth);
+    }
+  }
+  string_key_insertion_sort(begin, end, depth);
+}
+
+inline void multikey_quick_sort(std::string* begin, std::string* end) {
+  std::size_t size = end - begin;
+  std::vector<StringKey> keys(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    keys[i].string = begin + i;
+  }
+
+  multikey_quick_sort(keys.data(), keys.data() + size, 0, false);
+
+  // apply the sorted order with one move per string
+  std::vector<std::string> sorted(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    sorted[i] = std::move(*keys[i].string);
+  }
+  std::move(sorted.begin(), sorted.end(), begin);
+}
+
+// MSD radix sort: the character at depth of every string is read once into
+// characters, then the strings are counted and distributed into buckets
+inline void msd_radix_sort(
+  std::string* begin,
+  std::string* end,
+  std::size_t depth,
+  std::string* buffer,
+  int* characters
+) {
+  std::size_t size = end - begin;
+  if (size <= static_cast<std::size_t>(STRING_INSERTION_SORT_THRESHOLD)) {
+    string_insertion_sort(begin, end, depth);
+    return;
+  }
+
+  // bucket 0 is for the strings that end before depth
+  std::size_t counts[ALPHABET_SIZE + 2];
+
+  // skip a long common prefix 7 characters at a time without moving anything
+  while (true) {
+    std::uint64_t key = key_at(*begin, depth);
+    std::string* iter = begin + 1;
+
+    while (iter != end && key_at(*iter, depth) == key) {
+      ++iter;
+    }
+
+    if (iter != end) {
+      break;
+    }
+
+    if (key_ends(key)) {
+      return;
+    }
+    depth += KEY_CHARACTERS;
+  }
+
+  std::fill(std::begin(counts), std::end(counts), 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    characters[i] = char_at(begin[i], depth) + 1;
+    ++counts[characters[i] + 1];
+  }
+
+  for (std::size_t bucket = 1; bucket < ALPHABET_SIZE + 2; ++bucket) {
+    counts[bucket] += counts[bucket - 1];
+  }
+
+  for (std::size_t i = 0; i < size; ++i) {
+    buffer[counts[characters[i]]++] = std::move(begin[i]);
+  }
+  std::move(buffer, buffer + size, begin);
+
+  // counts[bucket] is now the end of bucket; the ended strings need no more work
+  for (std::size_t bucket = 1; bucket <= ALPHABET_SIZE; ++bucket) {
+    std::size_t from = counts[bucket - 1], to = counts[bucket];
+    if (to - from > 1) {
+      msd_radix_sort(begin + from, begin + to, depth + 1, buffer, characters);
+    }
+  }
+}
+
+inline void msd_radix_sort(std::string* begin, std::string* end) {
+  std::vector<std::string> buffer(end - begin);
+  std::vector<int> characters(end - begin);
+
+  msd_radix_sort(begin, end, 0, buffer.data(), characters.data());
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "benchmark.hpp"
+#include "sorting.hpp"
+#include "string_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+std::vector<std::string> generate_urls(std::size_t size, std::mt19937& generator) {
+  const char* hosts[] = {"https://api.example.com", "https://www.example.com", "https://cdn.example.org"};
+  const char* paths[] = {"/v2/users/", "/v2/orders/", "/v1/catalog/products/", "/static/images/"};
+  std::vector<std::string> result;
+
+  for (std::size_t i = 0; i < size; ++i) {
+    result.push_back(
+      std::string(hosts[generator() % 3]) + paths[generator() % 4] +
+      std::to_string(generator() % 100000) + "?session=" + std::to_string(generator())
+    );
+  }
+
+  return result;
+}
+
+std::vector<std::string> generate_log_lines(std::size_t size, std::mt19937& generator) {
+  const char* levels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+  const char* services[] = {"[gateway]", "[auth-service]", "[order-service]"};
+  std::vector<std::string> result;
+
+  for (std::size_t i = 0; i < size; ++i) {
+    std::size_t second = i / 1000;
+    char timestamp[32];
+    std::snprintf(
+      timestamp, sizeof(timestamp), "2026-10-17T%02zu:%02zu:%02zu.%03zuZ ",
+      second / 3600 % 24, second / 60 % 60, second % 60, i % 1000
+    );
+
+    result.push_back(
+      std::string(timestamp) + levels[generator() % 4] + ' ' + services[generator() % 3] +
+      " request handled path=/v2/users/" + std::to_string(generator() % 1000) +
+      " latency_ms=" + std::to_string(generator() % 500)
+    );
+  }
+
+  std::shuffle(result.begin(), result.end(), generator);
+  return result;
+}
+
+void run(const std::string& name, const std::vector<std::string>& input) {
+  bool sorted = true;
+
+  double quick = measure(input, [](std::string* begin, std::string* end) { quick_sort(begin, end); });
+  double standard = measure(input, [](std::string* begin, std::string* end) { std::sort(begin, end); });
+  double multikey = measure(input, [](std::string* begin, std::string* end) {
+    multikey_quick_sort(begin, end);
+  }, &sorted);
+  double msd = measure(input, [](std::string* begin, std::string* end) {
+    msd_radix_sort(begin, end);
+  }, sorted ? &sorted : nullptr);
+
+  std::cout << std::setw(10) << name
+            << std::setw(12) << std::fixed << std::setprecision(2) << quick << "ms"
+            << std::setw(12) << standard << "ms"
+            << std::setw(12) << multikey << "ms"
+            << std::setw(12) << msd << "ms"
+            << (sorted ? "" : "  NOT SORTED") << '\n';
+}
+
+// usage: string_sort_benchmark [size]
+int main(int argc, char* argv[]) {
+  std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::mt19937 generator(42);
+
+  std::cout << std::setw(10) << "corpus"
+            << std::setw(14) << "quick_sort"
+            << std::setw(14) << "std::sort"
+            << std::setw(14) << "multikey"
+            << std::setw(14) << "msd_radix" << '\n';
+
+  run("urls", generate_urls(size, generator));
+  run("log lines", generate_log_lines(size, generator));
+
+  return 0;
+}
@@ -0,0 +1,203 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// counts the unfinished tasks spawned in a fork-join scope - a pool calls add when a task
+// of the group is spawned and finish after the task has run
+class TaskGroup {
+public:
+  TaskGroup() : remaining(0) {}
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  bool done() const {
+    return remaining.load(std::memory_order_acquire) == 0;
+  }
+
+  void add() {
+    remaining.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // publishes the effects of the task to the thread that sees done()
+  void finish() {
+    remaining.fetch_sub(1, std::memory_order_release);
+  }
+
+private:
+  std::atomic<std::size_t> remaining;
+};
+
+// Work-stealing thread pool. Every worker owns a deque of tasks - it pushes and
+// pops at the back (LIFO, so recently split subranges stay in its cache) while
+// idle workers steal from the front, where the largest pieces of work are.
+// A pool of n threads starts n - 1 workers - the thread waiting on a TaskGroup
+// executes tasks too and acts as worker 0.
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency())
+    : pending(0), steals(0), stopping(false) {
+    if (threads == 0) {
+      threads = 1;
+    }
+
+    for (unsigned i = 0; i < threads; ++i) {
+      queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    for (unsigned i = 1; i < threads; ++i) {
+      workers.emplace_back([this, i]() { work(i); });
+    }
+  }
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      stopping = true;
+    }
+    sleep.notify_all();
+
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  std::size_t thread_count() const {
+    return queues.size();
+  }
+
+  void spawn(TaskGroup& group, Task task) {
+    group.add();
+    submit([&group, task = std::move(task)]() {
+      task();
+      group.finish();
+    });
+  }
+
+  // runs pending tasks on the calling thread until all tasks of the group finish
+  void wait(TaskGroup& group) {
+    std::size_t index = current_index();
+
+    while (!group.done()) {
+      if (!run_one(index)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  std::size_t steal_count() const {
+    return steals.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<std::size_t> pending, steals;
+
+  std::mutex sleep_mutex;
+  std::condition_variable sleep;
+  bool stopping;
+
+  static thread_local const ThreadPool* current_pool;
+  static thread_local std::size_t current_worker;
+
+  std::size_t current_index() const {
+    return current_pool == this ? current_worker : 0;
+  }
+
+  void submit(Task task) {
+    WorkQueue& queue = *queues[current_index()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+
+    pending.fetch_add(1, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    sleep.notify_one();
+  }
+
+  bool pop(std::size_t index, Task& task) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty()) {
+      return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+  }
+
+  bool steal(std::size_t index, Task& task) {
+    for (std::size_t i = 1; i < queues.size(); ++i) {
+      WorkQueue& victim = *queues[(index + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool run_one(std::size_t index) {
+    Task task;
+    if (!pop(index, task) && !steal(index, task)) {
+      return false;
+    }
+
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+  }
+
+  void work(std::size_t index) {
+    current_pool = this;
+    current_worker = index;
+
+    while (true) {
+      if (run_one(index)) {
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      sleep.wait(lock, [this]() {
+        return stopping || pending.load(std::memory_order_acquire) > 0;
+      });
+
+      if (stopping) {
+        return;
+      }
+    }
+  }
+};
+
+inline thread_local const ThreadPool* ThreadPool::current_pool = nullptr;
+inline thread_local std::size_t ThreadPool::current_worker = 0;
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef ARRAY_STACK_HPP
+#define ARRAY_STACK_HPP
+
+#include "stack.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Stack over contiguous storage that doubles when full. The first InlineCapacity
+// elements live inside the object itself, so small stacks never allocate.
+template <typename T, std::size_t InlineCapacity = 0>
+class ArrayStack : public Stack<T> {
+public:
+  ArrayStack() : data(inline_data()), size(0), capacity(InlineCapacity) {}
+  ArrayStack(const ArrayStack& other) : ArrayStack() {
+    reserve(other.size);
+    std::uninitialized_copy(other.data, other.data + other.size, data);
+    size = other.size;
+  }
+  ArrayStack(ArrayStack&& other) : ArrayStack() {
+    take(std::move(other));
+  }
+  ~ArrayStack() {
+    release();
+  }
+  ArrayStack& operator=(const ArrayStack& other) {
+    ArrayStack copy(other);
+    return *this = std::move(copy);
+  }
+  ArrayStack& operator=(ArrayStack&& other) {
+    if (this != &other) {
+      release();
+      take(std::move(other));
+    }
+
+    return *this;
+  }
+
+  void push(const T& element) {
+    emplace(element);
+  }
+
+  void push(T&& element) {
+    emplace(std::move(element));
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    if (size == capacity) {
+      grow_and_emplace(std::forward<Args>(args)...);
+    } else {
+      new (data + size) T(std::forward<Args>(args)...);
+    }
+
+    ++size;
+  }
+
+  T pop() {
+    T result = std::move(data[size - 1]);
+    data[--size].~T();
+    return result;
+  }
+
+  T& peek() {
+    return data[size - 1];
+  }
+
+  const T& peek() const {
+    return data[size - 1];
+  }
+
+  bool empty() const {
+    return size == 0;
+  }
+
+  std::size_t get_size() const {
+    return size;
+  }
+
+  void reserve(std::size_t new_capacity) {
+    if (new_capacity > capacity) {
+      reallocate(new_capacity);
+    }
+  }
+
+private:
+  T* data;
+  std::size_t size, capacity;
+  alignas(T) unsigned char inline_storage[InlineCapacity ? InlineCapacity * sizeof(T) : 1];
+
+  T* inline_data() {
+    return reinterpret_cast<T*>(inline_storage);
+  }
+
+  bool is_inline() {
+    return data == inline_data();
+  }
+
+  static T* allocate(std::size_t count) {
+    return std::allocator<T>().allocate(count);
+  }
+
+  void deallocate() {
+    if (!is_inline()) {
+      std::allocator<T>().deallocate(data, capacity);
+    }
+  }
+
+  void reallocate(std::size_t new_capacity) {
+    T* new_data = allocate(new_capacity);
+    std::uninitialized_move(data, data + size, new_data);
+    std::destroy(data, data + size);
+    deallocate();
+
+    data = new_data;
+    capacity = new_capacity;
+  }
+
+  // the new element is constructed before the old ones are moved, since
+  // the arguments may refer to an element of this stack
+  template <typename... Args>
+  void grow_and_emplace(Args&&... args) {
+    std::size_t new_capacity = capacity ? 2 * capacity : 8;
+    T* new_data = allocate(new_capacity);
+
+    new (new_data + size) T(std::forward<Args>(args)...);
+    std::uninitialized_move(data, data + size, new_data);
+    std::destroy(data, data + size);
+    deallocate();
+
+    data = new_data;
+    capacity = new_capacity;
+  }
+
+  void release() {
+    std::destroy(data, data + size);
+    deallocate();
+
+    data = inline_data();
+    size = 0;
+    capacity = InlineCapacity;
+  }
+
+  // expects this stack to be empty and inline
+  void take(ArrayStack&& other) {
+    if (other.is_inline()) {
+      std::uninitialized_move(other.data, other.data + other.size, data);
+      size = other.size;
+      other.release();
+    } else {
+      data = std::exchange(other.data, other.inline_data());
+      size = std::exchange(other.size, 0);
+      capacity = std::exchange(other.capacity, InlineCapacity);
+    }
+  }
+};
+
+#endif
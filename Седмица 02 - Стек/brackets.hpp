@@ -0,0 +1,251 @@
+#ifndef BRACKETS_HPP
+#define BRACKETS_HPP
+
+#include "../Седмица 01 - Сложност на алгоритми/thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+constexpr std::size_t BRACKET_CHUNK_SIZE = 1 << 16;
+// the parallel mode gives every thread this many pieces of the input to balance the load
+constexpr std::size_t BRACKET_PIECES_PER_THREAD = 4;
+
+// 1, 2, 3 for the opening and -1, -2, -3 for the closing brackets, 0 for anything else
+constexpr std::array<std::int8_t, 256> make_bracket_table() {
+  std::array<std::int8_t, 256> table{};
+  table['('] = 1;
+  table['['] = 2;
+  table['{'] = 3;
+  table[')'] = -1;
+  table[']'] = -2;
+  table['}'] = -3;
+  return table;
+}
+
+constexpr std::array<std::int8_t, 256> BRACKET_TABLE = make_bracket_table();
+
+#ifdef __AVX2__
+// one bit for every bracket among the 32 bytes at data
+inline std::uint32_t bracket_mask(const char* data) {
+  __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  // '(' and ')' differ only in the lowest bit of their codes
+  __m256i round = _mm256_cmpeq_epi8(_mm256_or_si256(bytes, _mm256_set1_epi8(1)), _mm256_set1_epi8(')'));
+  __m256i square = _mm256_or_si256(
+    _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('[')),
+    _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']')));
+  __m256i curly = _mm256_or_si256(
+    _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('{')),
+    _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('}')));
+  return _mm256_movemask_epi8(_mm256_or_si256(round, _mm256_or_si256(square, curly)));
+}
+#endif
+
+// What is left of a piece of text after matching its brackets: the closers that
+// matched nothing before it and the openers still waiting for a closer after it.
+// The text is balanced when both are empty and no closer met an opener of another kind.
+// Fed piece by piece it is a streaming validator, combined in order it joins
+// the summaries of neighbouring pieces.
+class BracketSummary {
+public:
+  BracketSummary() : mismatch(NO_ERROR), offset(0) {}
+
+  static constexpr std::size_t NO_ERROR = std::size_t(-1);
+
+  // scans the next size bytes of the text
+  void feed(const char* data, std::size_t size) {
+    std::size_t i = 0;
+
+#ifdef __AVX2__
+    for (; i + 32 <= size; i += 32) {
+      for (std::uint32_t mask = bracket_mask(data + i); mask; mask &= mask - 1) {
+        std::size_t position = i + __builtin_ctz(mask);
+        take(BRACKET_TABLE[static_cast<unsigned char>(data[position])], position);
+      }
+    }
+#endif
+
+    for (; i < size; ++i) {
+      if (std::int8_t kind = BRACKET_TABLE[static_cast<unsigned char>(data[i])]) {
+        take(kind, i);
+      }
+    }
+
+    offset += size;
+  }
+
+  void feed(const std::string& text) {
+    feed(text.data(), text.size());
+  }
+
+  // appends the summary of the text right after this one
+  void combine(const BracketSummary& next) {
+    if (next.mismatch != NO_ERROR) {
+      set_mismatch(offset + next.mismatch);
+    }
+
+    for (std::size_t i = 0; i < next.closers.size(); ++i) {
+      if (openers.empty()) {
+        closers.push_back(next.closers[i]);
+        closer_offsets.push_back(offset + next.closer_offsets[i]);
+      } else if (openers.back() != next.closers[i]) {
+        set_mismatch(offset + next.closer_offsets[i]);
+        openers.pop_back();
+      } else {
+        openers.pop_back();
+      }
+    }
+
+    openers.insert(openers.end(), next.openers.begin(), next.openers.end());
+    offset += next.offset;
+  }
+
+  // true if the text up to now has no closer without a matching opener
+  bool valid_so_far() const {
+    return mismatch == NO_ERROR && closers.empty();
+  }
+
+  bool balanced() const {
+    return valid_so_far() && openers.empty();
+  }
+
+  // the offset of the first bracket that breaks the balance, the length of the text
+  // for an opener that is never closed, NO_ERROR for a balanced text
+  std::size_t error_offset() const {
+    if (!closers.empty()) {
+      return std::min(mismatch, closer_offsets.front());
+    }
+
+    return mismatch != NO_ERROR || openers.empty() ? mismatch : offset;
+  }
+
+  std::size_t size() const {
+    return offset;
+  }
+
+private:
+  // the kinds 1..3 as bytes - a compact stack instead of a node per bracket
+  std::vector<std::int8_t> openers;
+  std::vector<std::int8_t> closers;
+  std::vector<std::size_t> closer_offsets;
+  // the first closer that met an opener of another kind
+  std::size_t mismatch;
+  std::size_t offset;
+
+  void set_mismatch(std::size_t position) {
+    mismatch = std::min(mismatch, position);
+  }
+
+  void take(std::int8_t kind, std::size_t position) {
+    if (kind > 0) {
+      openers.push_back(kind);
+    } else if (openers.empty()) {
+      closers.push_back(-kind);
+      closer_offsets.push_back(offset + position);
+    } else {
+      if (openers.back() != -kind) {
+        set_mismatch(offset + position);
+      }
+      openers.pop_back();
+    }
+  }
+};
+
+inline bool balanced(const std::string& text) {
+  BracketSummary summary;
+  summary.feed(text);
+  return summary.balanced();
+}
+
+// reads the stream in chunks and stops at the first unmatched closer
+inline BracketSummary validate_brackets(std::istream& input, std::size_t chunk_size = BRACKET_CHUNK_SIZE) {
+  BracketSummary summary;
+  std::vector<char> chunk(chunk_size);
+
+  while (summary.valid_so_far() && input) {
+    input.read(chunk.data(), chunk.size());
+    summary.feed(chunk.data(), input.gcount());
+  }
+
+  return summary;
+}
+
+inline BracketSummary validate_brackets_file(const std::string& path, std::size_t chunk_size = BRACKET_CHUNK_SIZE) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input) {
+    throw std::runtime_error("validate_brackets_file: cannot open " + path);
+  }
+
+  return validate_brackets(input, chunk_size);
+}
+
+// every thread summarises its own pieces, the summaries are then combined in order
+inline BracketSummary parallel_validate_brackets(const char* data, std::size_t size, ThreadPool& pool) {
+  std::size_t pieces = std::max<std::size_t>(1, std::min(pool.thread_count() * BRACKET_PIECES_PER_THREAD, size / BRACKET_CHUNK_SIZE));
+  std::vector<BracketSummary> summaries(pieces);
+  TaskGroup group;
+
+  for (std::size_t i = 0; i < pieces; ++i) {
+    pool.spawn(group, [&summaries, data, size, pieces, i]() {
+      std::size_t begin = size * i / pieces;
+      std::size_t end = size * (i + 1) / pieces;
+      summaries[i].feed(data + begin, end - begin);
+    });
+  }
+  pool.wait(group);
+
+  BracketSummary result;
+  for (const BracketSummary& summary : summaries) {
+    result.combine(summary);
+  }
+
+  return result;
+}
+
+// the same over a file - every piece is read through its own stream in chunks
+inline BracketSummary parallel_validate_brackets_file(const std::string& path, ThreadPool& pool, std::size_t chunk_size = BRACKET_CHUNK_SIZE) {
+  std::ifstream probe(path, std::ios::binary | std::ios::ate);
+  if (!probe) {
+    throw std::runtime_error("parallel_validate_brackets_file: cannot open " + path);
+  }
+
+  std::size_t size = probe.tellg();
+  std::size_t pieces = std::max<std::size_t>(1, std::min(pool.thread_count() * BRACKET_PIECES_PER_THREAD, size / chunk_size));
+  std::vector<BracketSummary> summaries(pieces);
+  TaskGroup group;
+
+  for (std::size_t i = 0; i < pieces; ++i) {
+    pool.spawn(group, [&summaries, &path, size, pieces, chunk_size, i]() {
+      std::size_t begin = size * i / pieces;
+      std::size_t left = size * (i + 1) / pieces - begin;
+      std::ifstream input(path, std::ios::binary);
+      input.seekg(begin);
+
+      std::vector<char> chunk(std::min(chunk_size, left));
+      while (left > 0 && input) {
+        input.read(chunk.data(), std::min(chunk.size(), left));
+        summaries[i].feed(chunk.data(), input.gcount());
+        left -= input.gcount();
+      }
+    });
+  }
+  pool.wait(group);
+
+  BracketSummary result;
+  for (const BracketSummary& summary : summaries) {
+    result.combine(summary);
+  }
+
+  return result;
+}
+
+#endif
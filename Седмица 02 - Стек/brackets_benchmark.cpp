@@ -0,0 +1,76 @@
+#include "benchmark.hpp"
+#include "brackets.hpp"
+#include "linked_stack.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+// the node per opener validator this replaces, with the empty stack check added
+bool linked_stack_balanced(const std::string& text) {
+  LinkedStack<char> brackets;
+
+  for (char c : text) {
+    if (c == '(' || c == '[' || c == '{') {
+      brackets.push(c);
+    } else if (c == ')' || c == ']' || c == '}') {
+      char opening = c == ')' ? '(' : c == ']' ? '[' : '{';
+      if (brackets.empty() || brackets.peek() != opening) {
+        return false;
+      }
+
+      brackets.pop();
+    }
+  }
+
+  return brackets.empty();
+}
+
+// a JSON-like dump: nested objects and arrays of short records
+std::string generate(std::size_t size) {
+  std::mt19937 generator(42);
+  std::string text = "[";
+
+  while (text.size() < size) {
+    text += "{\"id\": " + std::to_string(generator() % 1000000) + ", \"tags\": [\"a\", \"b\"], \"point\": {\"x\": 1, \"y\": 2}, \"name\": \"record\"},\n";
+  }
+  text += "{}]";
+
+  return text;
+}
+
+// usage: brackets_benchmark [megabytes]
+int main(int argc, char* argv[]) {
+  std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+  std::string text = generate(megabytes << 20);
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "brackets_benchmark.json";
+  std::ofstream(path, std::ios::binary).write(text.data(), text.size());
+
+  ThreadPool pool(std::thread::hardware_concurrency());
+  std::cout << text.size() / double(1 << 20) << "MB, " << pool.thread_count() << " threads\n";
+
+  auto report = [&text](const std::string& name, const auto& validate) {
+    bool result = false;
+    double time = measure([&]() { result = validate(); });
+
+    std::cout << std::setw(24) << name
+              << std::setw(10) << std::fixed << std::setprecision(1) << time << "ms"
+              << std::setw(10) << std::setprecision(2) << text.size() / time / 1e6 << "GB/s"
+              << (result ? "" : "  NOT BALANCED") << '\n';
+  };
+
+  report("LinkedStack<char>", [&]() { return linked_stack_balanced(text); });
+  report("in memory", [&]() { return balanced(text); });
+  report("streaming file", [&]() { return validate_brackets_file(path.string()).balanced(); });
+  report("parallel in memory", [&]() {
+    return parallel_validate_brackets(text.data(), text.size(), pool).balanced();
+  });
+  report("parallel file", [&]() { return parallel_validate_brackets_file(path.string(), pool).balanced(); });
+
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include "brackets.hpp"
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+int failures = 0;
+
+void check(bool condition, const std::string& description) {
+  if (!condition) {
+    std::cout << "FAILED: " << description << '\n';
+    ++failures;
+  }
+}
+
+// the LinkedStack-style reference: the offset of the first offending bracket
+std::size_t reference_error(const std::string& text) {
+  std::string open;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    char c = text[i];
+    if (c == '(' || c == '[' || c == '{') {
+      open.push_back(c);
+    } else if (c == ')' || c == ']' || c == '}') {
+      char expected = c == ')' ? '(' : c == ']' ? '[' : '{';
+      if (open.empty() || open.back() != expected) {
+        return i;
+      }
+      open.pop_back();
+    }
+  }
+
+  return open.empty() ? BracketSummary::NO_ERROR : text.size();
+}
+
+// usage: brackets_test - prints the failed checks, exits with 1 when there are any
+int main() {
+  check(balanced(""), "empty text is balanced");
+  check(balanced("f(a[1], {b: (2)})"), "nested brackets are balanced");
+  // the old LinkedStack version called peek on an empty stack here
+  check(!balanced(")("), "a leading closer is unbalanced");
+  check(!balanced("(]"), "mismatched kinds are unbalanced");
+  check(!balanced("(("), "an unclosed opener is unbalanced");
+
+  // every mode against the reference, with pieces and chunks much smaller than the text
+  std::mt19937 random(42);
+  const std::string alphabet = "()[]{}ab";
+  ThreadPool pool(4);
+
+  for (int round = 0; round < 2000; ++round) {
+    std::size_t length = random() % 300;
+    std::string text;
+    // mostly balanced text, so the errors are deep inside it and not at the first byte
+    std::string open;
+    for (std::size_t i = 0; i < length; ++i) {
+      unsigned choice = random() % 16;
+      if (choice < 6) {
+        std::size_t kind = random() % 3;
+        text += alphabet[2 * kind];
+        open += alphabet[2 * kind + 1];
+      } else if (choice < 12 && !open.empty()) {
+        text += open.back();
+        open.pop_back();
+      } else if (choice < 13) {
+        text += alphabet[random() % alphabet.size()];
+      } else {
+        text += 'a';
+      }
+    }
+    if (round % 2) {
+      text.append(open.rbegin(), open.rend());
+    }
+
+    std::size_t expected = reference_error(text);
+    BracketSummary whole;
+    whole.feed(text);
+    check(whole.error_offset() == expected, "error offset of \"" + text + "\"");
+    check(whole.balanced() == (expected == BracketSummary::NO_ERROR), "balance of \"" + text + "\"");
+
+    std::istringstream input(text);
+    BracketSummary streamed = validate_brackets(input, 7);
+    check(streamed.balanced() == whole.balanced(), "streamed balance of \"" + text + "\"");
+
+    BracketSummary parallel = parallel_validate_brackets(text.data(), text.size(), pool);
+    check(parallel.error_offset() == expected, "parallel error offset of \"" + text + "\"");
+
+    BracketSummary combined;
+    for (std::size_t begin = 0; begin < text.size(); begin += 5) {
+      BracketSummary piece;
+      piece.feed(text.substr(begin, 5));
+      combined.combine(piece);
+    }
+    check(combined.error_offset() == expected, "combined error offset of \"" + text + "\"");
+  }
+
+  std::cout << (failures ? "" : "all checks passed\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,261 @@
+#ifndef CONCURRENT_STACK_HPP
+#define CONCURRENT_STACK_HPP
+
+#include "stack.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+static_assert(sizeof(void*) == 8, "TaggedPointer packs a 16 bit tag into the unused top bits of a 64 bit pointer");
+
+constexpr std::size_t ELIMINATION_SLOTS = 8;
+// how many times a pusher checks its elimination slot before taking the node back
+constexpr unsigned ELIMINATION_SPINS = 64;
+
+// user space addresses fit in 48 bits, the top 16 count the changes of the word
+// so a compare_exchange that sees the same pointer after a pop and a push fails (ABA)
+template <typename Node>
+class TaggedPointer {
+public:
+  TaggedPointer() : bits(0) {}
+  TaggedPointer(Node* node, std::uint16_t tag)
+    : bits(reinterpret_cast<std::uintptr_t>(node) | std::uint64_t(tag) << POINTER_BITS) {}
+
+  Node* node() const {
+    return reinterpret_cast<Node*>(bits & POINTER_MASK);
+  }
+
+  std::uint16_t tag() const {
+    return std::uint16_t(bits >> POINTER_BITS);
+  }
+
+  // the same node with the next tag - the value to publish in place of this one
+  TaggedPointer with(Node* node) const {
+    return TaggedPointer(node, std::uint16_t(tag() + 1));
+  }
+
+private:
+  static constexpr unsigned POINTER_BITS = 48;
+  static constexpr std::uint64_t POINTER_MASK = (std::uint64_t(1) << POINTER_BITS) - 1;
+
+  std::uint64_t bits;
+};
+
+// Treiber stack - a linked stack whose top is swung with compare_exchange.
+// Popped nodes are never freed while the stack lives, they go to a lock-free free list
+// and are reused by later pushes, so a thread still reading a popped node's next
+// reads valid memory and the tag makes its compare_exchange fail.
+// When the top is contended, a push and a pop meet in the elimination array
+// and hand the node over without touching the top at all.
+template <typename T>
+class ConcurrentStack : public Stack<T> {
+public:
+  ConcurrentStack() {
+    for (auto& slot : slots) {
+      slot.value.store(TaggedPointer<Node>(), std::memory_order_relaxed);
+    }
+  }
+  ConcurrentStack(const ConcurrentStack&) = delete;
+  ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+  ~ConcurrentStack() {
+    Node* node = top.load(std::memory_order_relaxed).node();
+    while (node) {
+      node->value()->~T();
+      delete std::exchange(node, node->next.load(std::memory_order_relaxed));
+    }
+
+    node = free_nodes.load(std::memory_order_relaxed).node();
+    while (node) {
+      delete std::exchange(node, node->next.load(std::memory_order_relaxed));
+    }
+  }
+
+  void push(const T& element) {
+    emplace(element);
+  }
+
+  void push(T&& element) {
+    emplace(std::move(element));
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    Node* node = allocate();
+    try {
+      new (node->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+      link(free_nodes, node);
+      throw;
+    }
+
+    TaggedPointer<Node> current = top.load(std::memory_order_relaxed);
+    while (true) {
+      node->next.store(current.node(), std::memory_order_relaxed);
+      if (top.compare_exchange_weak(current, current.with(node), std::memory_order_release, std::memory_order_relaxed)) {
+        return;
+      }
+
+      if (eliminate_push(node)) {
+        return;
+      }
+      current = top.load(std::memory_order_relaxed);
+    }
+  }
+
+  // the safe way to pop while other threads may empty the stack
+  bool try_pop(T& result) {
+    Node* node = unlink();
+    if (!node) {
+      return false;
+    }
+
+    result = std::move(*node->value());
+    node->value()->~T();
+    link(free_nodes, node);
+    return true;
+  }
+
+  T pop() {
+    Node* node = unlink();
+    if (!node) {
+      throw std::out_of_range("ConcurrentStack: pop from an empty stack");
+    }
+
+    T result = std::move(*node->value());
+    node->value()->~T();
+    link(free_nodes, node);
+    return result;
+  }
+
+  // only valid while no other thread pops - the node may be reused right after
+  T& peek() {
+    return *top.load(std::memory_order_acquire).node()->value();
+  }
+
+  const T& peek() const {
+    return *top.load(std::memory_order_acquire).node()->value();
+  }
+
+  bool empty() const {
+    return !top.load(std::memory_order_acquire).node();
+  }
+
+  // how many pushes were handed to a pop through the elimination array
+  std::size_t elimination_count() const {
+    return eliminations.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Node {
+    alignas(T) unsigned char storage[sizeof(T)];
+    // atomic since a stale reader may load it while the node is relinked
+    std::atomic<Node*> next;
+
+    T* value() {
+      return std::launder(reinterpret_cast<T*>(storage));
+    }
+  };
+
+  struct alignas(64) Slot {
+    std::atomic<TaggedPointer<Node>> value;
+  };
+
+  alignas(64) std::atomic<TaggedPointer<Node>> top{TaggedPointer<Node>()};
+  alignas(64) std::atomic<TaggedPointer<Node>> free_nodes{TaggedPointer<Node>()};
+  alignas(64) std::atomic<std::size_t> eliminations{0};
+  Slot slots[ELIMINATION_SLOTS];
+
+  static void link(std::atomic<TaggedPointer<Node>>& list, Node* node) {
+    TaggedPointer<Node> current = list.load(std::memory_order_relaxed);
+    do {
+      node->next.store(current.node(), std::memory_order_relaxed);
+    } while (!list.compare_exchange_weak(current, current.with(node), std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  static Node* unlink_from(std::atomic<TaggedPointer<Node>>& list) {
+    TaggedPointer<Node> current = list.load(std::memory_order_acquire);
+    while (current.node()) {
+      Node* next = current.node()->next.load(std::memory_order_relaxed);
+      if (list.compare_exchange_weak(current, current.with(next), std::memory_order_acquire, std::memory_order_acquire)) {
+        return current.node();
+      }
+    }
+
+    return nullptr;
+  }
+
+  Node* allocate() {
+    Node* node = unlink_from(free_nodes);
+    return node ? node : new Node;
+  }
+
+  // takes the top node, or one offered by a push in the elimination array
+  Node* unlink() {
+    TaggedPointer<Node> current = top.load(std::memory_order_acquire);
+    while (current.node()) {
+      Node* next = current.node()->next.load(std::memory_order_relaxed);
+      if (top.compare_exchange_weak(current, current.with(next), std::memory_order_acquire, std::memory_order_acquire)) {
+        return current.node();
+      }
+
+      if (Node* node = eliminate_pop()) {
+        return node;
+      }
+      current = top.load(std::memory_order_acquire);
+    }
+
+    return nullptr;
+  }
+
+  static std::size_t slot_index() {
+    // each thread starts from its own slot and tries the next one every time
+    thread_local std::size_t index = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return index++ % ELIMINATION_SLOTS;
+  }
+
+  // offers the node in a slot for a while, true when a pop took it
+  bool eliminate_push(Node* node) {
+    Slot& slot = slots[slot_index()];
+    TaggedPointer<Node> empty = slot.value.load(std::memory_order_relaxed);
+    if (empty.node()) {
+      return false;
+    }
+
+    TaggedPointer<Node> offer = empty.with(node);
+    if (!slot.value.compare_exchange_strong(empty, offer, std::memory_order_release, std::memory_order_relaxed)) {
+      return false;
+    }
+
+    for (unsigned i = 0; i < ELIMINATION_SPINS; ++i) {
+      if (slot.value.load(std::memory_order_relaxed).node() != node) {
+        break;
+      }
+    }
+
+    // the tag tells our offer apart from a later offer of the same node
+    if (slot.value.compare_exchange_strong(offer, offer.with(nullptr), std::memory_order_relaxed)) {
+      return false;
+    }
+
+    eliminations.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  Node* eliminate_pop() {
+    Slot& slot = slots[slot_index()];
+    TaggedPointer<Node> offer = slot.value.load(std::memory_order_acquire);
+
+    if (offer.node() && slot.value.compare_exchange_strong(offer, offer.with(nullptr), std::memory_order_acquire, std::memory_order_relaxed)) {
+      return offer.node();
+    }
+
+    return nullptr;
+  }
+};
+
+#endif
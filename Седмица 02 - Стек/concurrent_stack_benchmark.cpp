@@ -0,0 +1,125 @@
+#include "benchmark.hpp"
+#include "concurrent_stack.hpp"
+#include "linked_stack.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// what the shared work stacks do today
+template <typename T>
+class MutexStack {
+public:
+  void push(const T& element) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stack.push(element);
+  }
+
+  bool try_pop(T& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stack.empty()) {
+      return false;
+    }
+
+    result = stack.pop();
+    return true;
+  }
+
+private:
+  std::mutex mutex;
+  LinkedStack<T> stack;
+};
+
+// every thread pushes a burst and pops as many as it pushed; returns ms and checks the checksum
+template <typename S>
+double run(std::size_t threads, std::size_t operations, bool& correct) {
+  S stack;
+  std::vector<long long> sums(threads, 0);
+
+  double time = measure([&]() {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&stack, &sums, t, threads, operations]() {
+        constexpr std::size_t BURST = 8;
+        long long sum = 0;
+
+        for (std::size_t i = 0; i < operations / threads / BURST; ++i) {
+          for (std::size_t j = 0; j < BURST; ++j) {
+            stack.push(int(i * BURST + j));
+            sum += int(i * BURST + j);
+          }
+
+          for (std::size_t j = 0; j < BURST; ++j) {
+            int value;
+            // another thread may have taken ours - someone else's push is on its way
+            while (!stack.try_pop(value)) {
+              std::this_thread::yield();
+            }
+            sum -= value;
+          }
+        }
+
+        sums[t] = sum;
+      });
+    }
+
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  });
+
+  long long total = 0;
+  for (long long sum : sums) {
+    total += sum;
+  }
+  correct = correct && total == 0;
+
+  return time;
+}
+
+// usage: concurrent_stack_benchmark [operations] [max threads]
+int main(int argc, char* argv[]) {
+  std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8000000;
+  std::size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2 * std::thread::hardware_concurrency();
+
+  std::cout << operations << " push + pop pairs, million pairs per second\n"
+            << std::setw(8) << "threads"
+            << std::setw(16) << "mutex stack"
+            << std::setw(16) << "treiber stack" << '\n';
+
+  bool correct = true;
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    double mutex_time = run<MutexStack<int>>(threads, operations, correct);
+    double lock_free_time = run<ConcurrentStack<int>>(threads, operations, correct);
+
+    std::cout << std::setw(8) << threads
+              << std::setw(16) << std::fixed << std::setprecision(2) << operations / mutex_time / 1000.0
+              << std::setw(16) << operations / lock_free_time / 1000.0 << '\n';
+  }
+
+  // the elimination array only pays off when many threads meet on the top
+  ConcurrentStack<int> stack;
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < max_threads; ++t) {
+    workers.emplace_back([&stack]() {
+      for (int i = 0; i < 100000; ++i) {
+        stack.push(i);
+        int value;
+        stack.try_pop(value);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  std::cout << "eliminated pairs with " << max_threads << " threads: " << stack.elimination_count() << '\n';
+
+  if (!correct) {
+    std::cout << "CHECKSUM MISMATCH\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,510 @@
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include "linked_stack.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// an expression is compiled once into postfix bytecode and then evaluated
+// over columns of variable values, one opcode at a time for a whole batch of rows
+
+// rows evaluated together - every operand stack slot is a batch of this many values
+constexpr std::size_t EXPRESSION_BATCH_SIZE = 256;
+
+enum class TokenType : std::uint8_t {
+  NUMBER,
+  VARIABLE,
+  ADD,
+  SUBTRACT,
+  MULTIPLY,
+  DIVIDE,
+  NEGATE,
+  LEFT_PARENTHESIS,
+  RIGHT_PARENTHESIS
+};
+
+struct Token {
+  TokenType type;
+  double value;
+  std::string name;
+};
+
+// The length of the decimal literal at start - digits with an optional fraction and
+// exponent, 0 when there are no digits. strtod alone would also take "0x10", "inf" and "nan".
+inline std::size_t scan_decimal(const std::string& expression, std::size_t start) {
+  auto digits = [&expression](std::size_t i) {
+    while (i < expression.size() && std::isdigit(static_cast<unsigned char>(expression[i]))) {
+      ++i;
+    }
+    return i;
+  };
+
+  std::size_t i = digits(start);
+  bool whole = i > start;
+  if (i < expression.size() && expression[i] == '.') {
+    std::size_t fraction = i + 1;
+    i = digits(fraction);
+    if (!whole && i == fraction) {
+      return 0;
+    }
+  } else if (!whole) {
+    return 0;
+  }
+
+  // the exponent is part of the number only when digits follow, "2e" is 2 and a variable e
+  if (i < expression.size() && (expression[i] == 'e' || expression[i] == 'E')) {
+    std::size_t exponent = i + 1;
+    if (exponent < expression.size() && (expression[exponent] == '+' || expression[exponent] == '-')) {
+      ++exponent;
+    }
+    if (digits(exponent) > exponent) {
+      i = digits(exponent);
+    }
+  }
+
+  return i - start;
+}
+
+// a minus is unary where an operand is expected - at the start, after an operator or a '('
+inline std::vector<Token> tokenize(const std::string& expression) {
+  std::vector<Token> tokens;
+  bool expects_operand = true;
+
+  for (std::size_t i = 0; i < expression.size();) {
+    char c = expression[i];
+
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      ++i;
+      continue;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+      std::size_t length = scan_decimal(expression, i);
+      // a lone '.' is not a number, and skipping nothing would never move past it
+      if (length == 0) {
+        throw std::invalid_argument(std::string("tokenize: unexpected character '") + c + "'");
+      }
+      tokens.push_back({TokenType::NUMBER, std::strtod(expression.substr(i, length).c_str(), nullptr), ""});
+      i += length;
+      expects_operand = false;
+    } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      std::size_t start = i;
+      while (i < expression.size() && (std::isalnum(static_cast<unsigned char>(expression[i])) || expression[i] == '_')) {
+        ++i;
+      }
+
+      tokens.push_back({TokenType::VARIABLE, 0, expression.substr(start, i - start)});
+      expects_operand = false;
+    } else {
+      TokenType type;
+      switch (c) {
+        case '+': type = TokenType::ADD; break;
+        case '-': type = expects_operand ? TokenType::NEGATE : TokenType::SUBTRACT; break;
+        case '*': type = TokenType::MULTIPLY; break;
+        case '/': type = TokenType::DIVIDE; break;
+        case '(': type = TokenType::LEFT_PARENTHESIS; break;
+        case ')': type = TokenType::RIGHT_PARENTHESIS; break;
+        default:
+          throw std::invalid_argument(std::string("tokenize: unexpected character '") + c + "'");
+      }
+
+      tokens.push_back({type, 0, ""});
+      expects_operand = type != TokenType::RIGHT_PARENTHESIS;
+      ++i;
+    }
+  }
+
+  return tokens;
+}
+
+enum class OpCode : std::uint8_t {
+  CONSTANT,
+  VARIABLE,
+  ADD,
+  SUBTRACT,
+  MULTIPLY,
+  DIVIDE,
+  NEGATE
+};
+
+struct Instruction {
+  OpCode code;
+  // index into the constants or the variables for CONSTANT and VARIABLE
+  std::uint32_t operand;
+};
+
+struct Program {
+  std::vector<Instruction> code;
+  std::vector<double> constants;
+  // in order of first appearance - the columns passed to evaluate follow this order
+  std::vector<std::string> variables;
+  // the deepest the operand stack gets
+  std::size_t stack_size = 0;
+};
+
+inline int get_precedence(TokenType type) {
+  switch (type) {
+    case TokenType::ADD: case TokenType::SUBTRACT:
+      return 1;
+    case TokenType::MULTIPLY: case TokenType::DIVIDE:
+      return 2;
+    case TokenType::NEGATE:
+      return 3;
+    default:
+      return 0;
+  }
+}
+
+inline OpCode to_opcode(TokenType type) {
+  switch (type) {
+    case TokenType::ADD: return OpCode::ADD;
+    case TokenType::SUBTRACT: return OpCode::SUBTRACT;
+    case TokenType::MULTIPLY: return OpCode::MULTIPLY;
+    case TokenType::DIVIDE: return OpCode::DIVIDE;
+    default: return OpCode::NEGATE;
+  }
+}
+
+inline void emit(Program& program, OpCode code, std::uint32_t operand, std::size_t& depth) {
+  if (code == OpCode::CONSTANT || code == OpCode::VARIABLE) {
+    program.stack_size = std::max(program.stack_size, ++depth);
+  } else if (code != OpCode::NEGATE) {
+    if (depth < 2) {
+      throw std::invalid_argument("compile: missing operand");
+    }
+    --depth;
+  } else if (depth < 1) {
+    throw std::invalid_argument("compile: missing operand");
+  }
+
+  program.code.push_back({code, operand});
+}
+
+// Shunting yard over the tokens; binary operators are left associative, negation is right associative.
+// Operands and operators must alternate - counting the stack depth alone would accept "x y -" or "(1)(2)+".
+inline Program compile(const std::string& expression) {
+  Program program;
+  LinkedStack<TokenType> operations;
+  std::size_t depth = 0;
+  bool expects_operand = true;
+
+  for (const Token& token : tokenize(expression)) {
+    bool operand_like = token.type == TokenType::NUMBER || token.type == TokenType::VARIABLE ||
+                        token.type == TokenType::LEFT_PARENTHESIS || token.type == TokenType::NEGATE;
+    if (operand_like != expects_operand) {
+      throw std::invalid_argument(expects_operand ? "compile: expected an operand" : "compile: expected an operator");
+    }
+    expects_operand = token.type != TokenType::NUMBER && token.type != TokenType::VARIABLE &&
+                      token.type != TokenType::RIGHT_PARENTHESIS;
+
+    switch (token.type) {
+      case TokenType::NUMBER:
+        emit(program, OpCode::CONSTANT, program.constants.size(), depth);
+        program.constants.push_back(token.value);
+        break;
+      case TokenType::VARIABLE: {
+        auto found = std::find(program.variables.begin(), program.variables.end(), token.name);
+        emit(program, OpCode::VARIABLE, found - program.variables.begin(), depth);
+        if (found == program.variables.end()) {
+          program.variables.push_back(token.name);
+        }
+        break;
+      }
+      case TokenType::LEFT_PARENTHESIS:
+      case TokenType::NEGATE:
+        operations.push(token.type);
+        break;
+      case TokenType::RIGHT_PARENTHESIS:
+        while (!operations.empty() && operations.peek() != TokenType::LEFT_PARENTHESIS) {
+          emit(program, to_opcode(operations.pop()), 0, depth);
+        }
+
+        if (operations.empty()) {
+          throw std::invalid_argument("compile: unbalanced ')'");
+        }
+        operations.pop();
+        break;
+      default:
+        while (
+          !operations.empty() &&
+          operations.peek() != TokenType::LEFT_PARENTHESIS &&
+          get_precedence(operations.peek()) >= get_precedence(token.type)
+        ) {
+          emit(program, to_opcode(operations.pop()), 0, depth);
+        }
+
+        operations.push(token.type);
+    }
+  }
+
+  if (expects_operand) {
+    throw std::invalid_argument("compile: expected an operand");
+  }
+
+  while (!operations.empty()) {
+    TokenType type = operations.pop();
+    if (type == TokenType::LEFT_PARENTHESIS) {
+      throw std::invalid_argument("compile: unbalanced '('");
+    }
+
+    emit(program, to_opcode(type), 0, depth);
+  }
+
+  if (depth != 1) {
+    throw std::invalid_argument("compile: expected a single expression");
+  }
+
+  return program;
+}
+
+// the shortest of 15 to 17 significant digits that reads back as the same double
+inline std::string format_constant(double value) {
+  std::ostringstream number;
+  for (int precision = std::numeric_limits<double>::digits10; ; ++precision) {
+    number.str("");
+    number << std::setprecision(precision) << value;
+    if (precision >= std::numeric_limits<double>::max_digits10 || std::strtod(number.str().c_str(), nullptr) == value) {
+      return number.str();
+    }
+  }
+}
+
+// the postfix form with spaces between the tokens, e.g. "x 12 + y * -"
+inline std::string to_string(const Program& program) {
+  std::string result;
+
+  for (const Instruction& instruction : program.code) {
+    if (!result.empty()) {
+      result += ' ';
+    }
+
+    switch (instruction.code) {
+      case OpCode::CONSTANT: {
+        result += format_constant(program.constants[instruction.operand]);
+        break;
+      }
+      case OpCode::VARIABLE: result += program.variables[instruction.operand]; break;
+      case OpCode::ADD: result += '+'; break;
+      case OpCode::SUBTRACT: result += '-'; break;
+      case OpCode::MULTIPLY: result += '*'; break;
+      case OpCode::DIVIDE: result += '/'; break;
+      case OpCode::NEGATE: result += '~'; break;
+    }
+  }
+
+  return result;
+}
+
+// one row at a time - the variables hold the values in the order of program.variables
+inline double evaluate(const Program& program, const double* variables) {
+  std::vector<double> stack(program.stack_size);
+  std::size_t top = 0;
+
+  for (const Instruction& instruction : program.code) {
+    switch (instruction.code) {
+      case OpCode::CONSTANT: stack[top++] = program.constants[instruction.operand]; break;
+      case OpCode::VARIABLE: stack[top++] = variables[instruction.operand]; break;
+      case OpCode::ADD: --top; stack[top - 1] += stack[top]; break;
+      case OpCode::SUBTRACT: --top; stack[top - 1] -= stack[top]; break;
+      case OpCode::MULTIPLY: --top; stack[top - 1] *= stack[top]; break;
+      case OpCode::DIVIDE: --top; stack[top - 1] /= stack[top]; break;
+      case OpCode::NEGATE: stack[top - 1] = -stack[top - 1]; break;
+    }
+  }
+
+  return stack[0];
+}
+
+// left = left op right for count values, four at a time with AVX
+template <OpCode Code>
+void apply_batch(double* left, const double* right, std::size_t count) {
+  std::size_t i = 0;
+
+#ifdef __AVX2__
+  for (; i + 4 <= count; i += 4) {
+    __m256d a = _mm256_loadu_pd(left + i);
+    __m256d b = _mm256_loadu_pd(right + i);
+
+    if constexpr (Code == OpCode::ADD) {
+      a = _mm256_add_pd(a, b);
+    } else if constexpr (Code == OpCode::SUBTRACT) {
+      a = _mm256_sub_pd(a, b);
+    } else if constexpr (Code == OpCode::MULTIPLY) {
+      a = _mm256_mul_pd(a, b);
+    } else {
+      a = _mm256_div_pd(a, b);
+    }
+
+    _mm256_storeu_pd(left + i, a);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    if constexpr (Code == OpCode::ADD) {
+      left[i] += right[i];
+    } else if constexpr (Code == OpCode::SUBTRACT) {
+      left[i] -= right[i];
+    } else if constexpr (Code == OpCode::MULTIPLY) {
+      left[i] *= right[i];
+    } else {
+      left[i] /= right[i];
+    }
+  }
+}
+
+// constants are used straight from the instruction instead of being broadcast into a batch
+template <OpCode Code>
+void apply_batch(double* left, double right, std::size_t count) {
+  std::size_t i = 0;
+
+#ifdef __AVX2__
+  __m256d b = _mm256_set1_pd(right);
+  for (; i + 4 <= count; i += 4) {
+    __m256d a = _mm256_loadu_pd(left + i);
+
+    if constexpr (Code == OpCode::ADD) {
+      a = _mm256_add_pd(a, b);
+    } else if constexpr (Code == OpCode::SUBTRACT) {
+      a = _mm256_sub_pd(a, b);
+    } else if constexpr (Code == OpCode::MULTIPLY) {
+      a = _mm256_mul_pd(a, b);
+    } else {
+      a = _mm256_div_pd(a, b);
+    }
+
+    _mm256_storeu_pd(left + i, a);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    if constexpr (Code == OpCode::ADD) {
+      left[i] += right;
+    } else if constexpr (Code == OpCode::SUBTRACT) {
+      left[i] -= right;
+    } else if constexpr (Code == OpCode::MULTIPLY) {
+      left[i] *= right;
+    } else {
+      left[i] /= right;
+    }
+  }
+}
+
+inline void negate_batch(double* values, std::size_t count) {
+  std::size_t i = 0;
+
+#ifdef __AVX2__
+  __m256d sign = _mm256_set1_pd(-0.0);
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(values + i, _mm256_xor_pd(_mm256_loadu_pd(values + i), sign));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    values[i] = -values[i];
+  }
+}
+
+// An operand on the stack is either a batch in the scratch buffer, a constant
+// or a column - columns and constants are only copied when an operator writes over them.
+struct BatchOperand {
+  const double* values;
+  double constant;
+  bool is_constant;
+};
+
+template <OpCode Code>
+void apply_batch(BatchOperand& left, const BatchOperand& right, double* target, std::size_t count) {
+  if (left.is_constant && right.is_constant) {
+    double result = left.constant;
+    apply_batch<Code>(&result, right.constant, 1);
+    left.constant = result;
+    return;
+  }
+
+  if (left.is_constant) {
+    std::fill(target, target + count, left.constant);
+  } else if (left.values != target) {
+    std::copy(left.values, left.values + count, target);
+  }
+
+  if (right.is_constant) {
+    apply_batch<Code>(target, right.constant, count);
+  } else {
+    apply_batch<Code>(target, right.values, count);
+  }
+
+  left = {target, 0, false};
+}
+
+// columns[v] holds rows values of program.variables[v]; writes rows results into result
+inline void evaluate(const Program& program, const double* const* columns, std::size_t rows, double* result) {
+  std::vector<double> scratch(program.stack_size * EXPRESSION_BATCH_SIZE);
+  std::vector<BatchOperand> stack(program.stack_size);
+  // the batch of stack slot i always lives in the same place of the scratch buffer
+  auto slot = [&scratch](std::size_t index) {
+    return scratch.data() + index * EXPRESSION_BATCH_SIZE;
+  };
+
+  for (std::size_t row = 0; row < rows; row += EXPRESSION_BATCH_SIZE) {
+    std::size_t count = std::min(EXPRESSION_BATCH_SIZE, rows - row);
+    std::size_t top = 0;
+
+    for (const Instruction& instruction : program.code) {
+      switch (instruction.code) {
+        case OpCode::CONSTANT:
+          stack[top++] = {nullptr, program.constants[instruction.operand], true};
+          break;
+        case OpCode::VARIABLE:
+          stack[top++] = {columns[instruction.operand] + row, 0, false};
+          break;
+        case OpCode::ADD: --top; apply_batch<OpCode::ADD>(stack[top - 1], stack[top], slot(top - 1), count); break;
+        case OpCode::SUBTRACT: --top; apply_batch<OpCode::SUBTRACT>(stack[top - 1], stack[top], slot(top - 1), count); break;
+        case OpCode::MULTIPLY: --top; apply_batch<OpCode::MULTIPLY>(stack[top - 1], stack[top], slot(top - 1), count); break;
+        case OpCode::DIVIDE: --top; apply_batch<OpCode::DIVIDE>(stack[top - 1], stack[top], slot(top - 1), count); break;
+        case OpCode::NEGATE: {
+          BatchOperand& operand = stack[top - 1];
+          double* target = slot(top - 1);
+          if (operand.is_constant) {
+            operand.constant = -operand.constant;
+          } else {
+            if (operand.values != target) {
+              std::copy(operand.values, operand.values + count, target);
+            }
+            negate_batch(target, count);
+            operand = {target, 0, false};
+          }
+          break;
+        }
+      }
+    }
+
+    if (stack[0].is_constant) {
+      std::fill(result + row, result + row + count, stack[0].constant);
+    } else {
+      std::copy(stack[0].values, stack[0].values + count, result + row);
+    }
+  }
+}
+
+inline void evaluate(const Program& program, const std::vector<const double*>& columns, std::size_t rows, double* result) {
+  if (columns.size() != program.variables.size()) {
+    throw std::invalid_argument("evaluate: expected one column per variable");
+  }
+
+  evaluate(program, columns.data(), rows, result);
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include "benchmark.hpp"
+#include "expression.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// usage: expression_benchmark [rows]
+int main(int argc, char* argv[]) {
+  std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  const std::string formula = "(price - cost) * quantity / (1 + tax) - -discount * 0.5";
+
+  Program program = compile(formula);
+  std::cout << formula << "\n  => " << to_string(program) << '\n';
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 100.0);
+  std::vector<std::vector<double>> columns(program.variables.size(), std::vector<double>(rows));
+  std::vector<const double*> column_pointers;
+  for (std::vector<double>& column : columns) {
+    for (double& value : column) {
+      value = distribution(generator);
+    }
+    column_pointers.push_back(column.data());
+  }
+
+  std::vector<double> batched(rows);
+  std::vector<double> row_by_row(rows);
+  std::vector<double> parsed(rows);
+
+  double batched_time = measure([&]() {
+    evaluate(program, column_pointers, rows, batched.data());
+  });
+
+  double row_time = measure([&]() {
+    std::vector<double> values(program.variables.size());
+    for (std::size_t row = 0; row < rows; ++row) {
+      for (std::size_t v = 0; v < values.size(); ++v) {
+        values[v] = columns[v][row];
+      }
+      row_by_row[row] = evaluate(program, values.data());
+    }
+  });
+
+  // what re-parsing the formula per row would cost, measured on a slice and scaled
+  std::size_t parsed_rows = std::min<std::size_t>(rows, 100000);
+  double parse_time = measure([&]() {
+    std::vector<double> values(program.variables.size());
+    for (std::size_t row = 0; row < parsed_rows; ++row) {
+      for (std::size_t v = 0; v < values.size(); ++v) {
+        values[v] = columns[v][row];
+      }
+      parsed[row] = evaluate(compile(formula), values.data());
+    }
+  }) * rows / parsed_rows;
+
+  bool same = true;
+  for (std::size_t row = 0; row < rows; ++row) {
+    same = same && std::abs(batched[row] - row_by_row[row]) <= 1e-9 * std::abs(row_by_row[row]);
+  }
+
+  auto report = [rows](const std::string& name, double time) {
+    std::cout << std::setw(28) << name
+              << std::setw(12) << std::fixed << std::setprecision(2) << time << "ms"
+              << std::setw(10) << time * 1e6 / rows << "ns/row\n";
+  };
+
+  std::cout << rows << " rows\n";
+  report("parse every row (scaled)", parse_time);
+  report("bytecode, row by row", row_time);
+  report("bytecode, column batches", batched_time);
+
+  if (!same) {
+    std::cout << "RESULTS DIFFER\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include "expression.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int failures = 0;
+
+void check(bool condition, const std::string& description) {
+  if (!condition) {
+    std::cout << "FAILED: " << description << '\n';
+    ++failures;
+  }
+}
+
+void check_rejected(const std::string& expression) {
+  try {
+    std::string compiled = to_string(compile(expression));
+    check(false, "\"" + expression + "\" is rejected, compiled to \"" + compiled + "\"");
+  } catch (const std::invalid_argument&) {
+  }
+}
+
+void check_compiles(const std::string& expression, const std::string& expected) {
+  try {
+    std::string compiled = to_string(compile(expression));
+    check(compiled == expected, "\"" + expression + "\" compiles to \"" + expected + "\", got \"" + compiled + "\"");
+  } catch (const std::invalid_argument& error) {
+    check(false, "\"" + expression + "\" compiles, threw " + error.what());
+  }
+}
+
+// usage: expression_test - prints the failed checks, exits with 1 when there are any
+int main() {
+  check_compiles("(price - cost) * quantity / (1 + tax) - -discount * 0.5",
+                 "price cost - quantity * 1 tax + / discount ~ 0.5 * -");
+  check_compiles("-x - -(y)", "x ~ y ~ -");
+  check_compiles("2.5e3 * .5 + 7.", "2500 0.5 * 7 +");
+
+  // a lone '.' used to loop in the tokenizer
+  for (const char* malformed : {".", "1+.", "x * . + 2"}) {
+    check_rejected(malformed);
+  }
+
+  // operands and operators out of order
+  for (const char* malformed : {"x y -", "+ 1 2", "2 3 4 * +", "(1)(2)+", "1 2", "x (y)", "(x) y",
+                                "1 +", "()", "(", ")", "", "*", "x * / y", "(x - ) * 2"}) {
+    check_rejected(malformed);
+  }
+
+  // only decimal literals - strtod would read these as 16, infinity and a NaN
+  for (const char* malformed : {"0x10", "1 + 0x1p3", "2e", "2e+"}) {
+    check_rejected(malformed);
+  }
+  check_compiles("inf + nan", "inf nan +");
+
+  // the printed constants read back as the same doubles
+  for (double constant : {1e-7, 0.1, 1.0 / 3, 12.0, 6.02214076e23}) {
+    std::string printed = to_string(compile(format_constant(constant)));
+    check(std::strtod(printed.c_str(), nullptr) == constant, "constant " + printed + " round-trips");
+  }
+
+  std::cout << (failures ? "" : "all checks passed\n");
+  return failures ? 1 : 0;
+}
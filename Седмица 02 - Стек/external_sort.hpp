@@ -0,0 +1,382 @@
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+
+#include "natural_merge_sort.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Sorts a binary file of fixed-size records that does not fit in memory:
+//   1. the input is cut into chunks that fit in the memory budget, every chunk is
+//      sorted in memory and written out as a run file;
+//   2. up to fan_in runs at a time are merged through a loser tree until one is left.
+// All file reads and writes are double-buffered and run asynchronously, so the
+// disk stays busy while the chunks are sorted and merged.
+
+struct ExternalSortStats {
+  std::uintmax_t bytes = 0;
+  std::size_t runs = 0;
+  std::size_t merge_passes = 0;
+  double run_generation_ms = 0;
+  double merge_ms = 0;
+};
+
+// a file whose size is not a multiple of the record size is an error, not a shorter output
+template <typename Record>
+std::size_t read_records(std::ifstream& file, Record* buffer, std::size_t count) {
+  file.read(reinterpret_cast<char*>(buffer), count * sizeof(Record));
+  if (file.gcount() % sizeof(Record) != 0) {
+    throw std::runtime_error("external_sort: the file ends with a partial record");
+  }
+
+  return file.gcount() / sizeof(Record);
+}
+
+template <typename Record>
+void write_records(std::ofstream& file, const Record* buffer, std::size_t count) {
+  file.write(reinterpret_cast<const char*>(buffer), count * sizeof(Record));
+  if (!file) {
+    throw std::runtime_error("external_sort: write failed");
+  }
+}
+
+// sequential reader that prefetches the next block while the current one is consumed
+template <typename Record>
+class RunReader {
+public:
+  RunReader(const std::filesystem::path& path, std::size_t block_size)
+    : file(path, std::ios::binary), current(block_size), next(block_size), position(0), size(0) {
+    if (!file) {
+      throw std::runtime_error("external_sort: cannot open " + path.string());
+    }
+
+    size = read_records(file, current.data(), current.size());
+    prefetch();
+  }
+  RunReader(const RunReader&) = delete;
+  RunReader& operator=(const RunReader&) = delete;
+  ~RunReader() {
+    if (pending.valid()) {
+      pending.wait();
+    }
+  }
+
+  bool exhausted() const {
+    return position == size;
+  }
+
+  const Record& peek() const {
+    return current[position];
+  }
+
+  void advance() {
+    if (++position < size) {
+      return;
+    }
+
+    size = pending.get();
+    position = 0;
+    std::swap(current, next);
+
+    if (size) {
+      prefetch();
+    }
+  }
+
+private:
+  std::ifstream file;
+  std::vector<Record> current, next;
+  std::size_t position, size;
+  std::future<std::size_t> pending;
+
+  void prefetch() {
+    pending = std::async(std::launch::async, [this]() {
+      return read_records(file, next.data(), next.size());
+    });
+  }
+};
+
+// buffered writer that flushes one block in the background while the other is filled
+template <typename Record>
+class RunWriter {
+public:
+  RunWriter(const std::filesystem::path& path, std::size_t block_size)
+    : file(path, std::ios::binary | std::ios::trunc), block_size(block_size) {
+    if (!file) {
+      throw std::runtime_error("external_sort: cannot create " + path.string());
+    }
+
+    current.reserve(block_size);
+    flushing.reserve(block_size);
+  }
+  RunWriter(const RunWriter&) = delete;
+  RunWriter& operator=(const RunWriter&) = delete;
+  ~RunWriter() {
+    if (pending.valid()) {
+      pending.wait();
+    }
+  }
+
+  void push(const Record& record) {
+    current.push_back(record);
+    if (current.size() == block_size) {
+      flush();
+    }
+  }
+
+  void finish() {
+    flush();
+    if (pending.valid()) {
+      pending.get();
+    }
+  }
+
+private:
+  std::ofstream file;
+  std::size_t block_size;
+  std::vector<Record> current, flushing;
+  std::future<void> pending;
+
+  void flush() {
+    if (pending.valid()) {
+      pending.get();
+    }
+
+    std::swap(current, flushing);
+    current.clear();
+    pending = std::async(std::launch::async, [this]() {
+      write_records(file, flushing.data(), flushing.size());
+    });
+  }
+};
+
+// tree[0] holds the index of the source with the smallest record, the inner
+// nodes hold the loser of the match played there; replaying after a source
+// advances touches only the path from its leaf to the root
+template <typename Record>
+class LoserTree {
+public:
+  LoserTree(std::deque<RunReader<Record>>& sources)
+    : sources(sources), tree(sources.size(), sources.size()) {
+    // index sources.size() is a virtual source that beats everything; it is pushed
+    // out of the tree as the real sources are played in
+    for (std::size_t i = sources.size(); i-- > 0;) {
+      replay(i);
+    }
+  }
+
+  std::size_t winner() const {
+    return tree[0];
+  }
+
+  bool empty() const {
+    return sources[tree[0]].exhausted();
+  }
+
+  void replay(std::size_t source) {
+    std::size_t winner = source;
+
+    for (std::size_t node = (source + tree.size()) / 2; node > 0; node /= 2) {
+      if (beats(tree[node], winner)) {
+        std::swap(tree[node], winner);
+      }
+    }
+
+    tree[0] = winner;
+  }
+
+private:
+  std::deque<RunReader<Record>>& sources;
+  std::vector<std::size_t> tree;
+
+  // exhausted sources lose to everything, ties go to the earlier run to keep the sort stable
+  bool beats(std::size_t a, std::size_t b) const {
+    std::size_t sentinel = sources.size();
+    if (a == sentinel || b == sentinel) {
+      return a == sentinel;
+    }
+
+    if (sources[a].exhausted() || sources[b].exhausted()) {
+      return !sources[a].exhausted();
+    }
+
+    if (sources[a].peek() < sources[b].peek()) return true;
+    if (sources[b].peek() < sources[a].peek()) return false;
+    return a < b;
+  }
+};
+
+template <typename Record>
+void merge_run_files(
+  const std::vector<std::filesystem::path>& inputs,
+  const std::filesystem::path& output,
+  std::size_t block_size
+) {
+  // the readers prefetch into their own buffers, so they must never move
+  std::deque<RunReader<Record>> sources;
+  for (const std::filesystem::path& input : inputs) {
+    sources.emplace_back(input, block_size);
+  }
+
+  RunWriter<Record> writer(output, block_size);
+  LoserTree<Record> tree(sources);
+
+  while (!tree.empty()) {
+    std::size_t winner = tree.winner();
+    writer.push(sources[winner].peek());
+    sources[winner].advance();
+    tree.replay(winner);
+  }
+
+  writer.finish();
+}
+
+template <typename Record>
+std::vector<std::filesystem::path> generate_runs(
+  const std::filesystem::path& input,
+  const std::filesystem::path& temp_directory,
+  const std::string& prefix,
+  std::size_t memory_budget,
+  ExternalSortStats& stats
+) {
+  std::ifstream file(input, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("external_sort: cannot open " + input.string());
+  }
+
+  // three chunks rotate between being read, sorted and written; sorting a chunk
+  // needs another half a chunk of scratch space
+  std::size_t chunk_size = std::max<std::size_t>(1, memory_budget * 2 / 7 / sizeof(Record));
+  std::vector<Record> chunks[3];
+  std::future<void> writes[3];
+  for (std::vector<Record>& chunk : chunks) {
+    chunk.resize(chunk_size);
+  }
+
+  std::vector<std::filesystem::path> runs;
+  std::future<std::size_t> read = std::async(std::launch::async, [&]() {
+    return read_records(file, chunks[0].data(), chunk_size);
+  });
+
+  try {
+    for (std::size_t i = 0;; ++i) {
+      std::size_t count = read.get();
+      if (count == 0) {
+        break;
+      }
+
+      std::vector<Record>& chunk = chunks[i % 3];
+      std::vector<Record>& next = chunks[(i + 1) % 3];
+      std::future<void>& next_write = writes[(i + 1) % 3];
+
+      if (next_write.valid()) {
+        next_write.get();
+      }
+      read = std::async(std::launch::async, [&file, &next, chunk_size]() {
+        return read_records(file, next.data(), chunk_size);
+      });
+
+      natural_merge_sort(chunk.data(), chunk.data() + count);
+      stats.bytes += count * sizeof(Record);
+
+      runs.push_back(temp_directory / (prefix + ".run0." + std::to_string(i)));
+      writes[i % 3] = std::async(std::launch::async, [&chunk, count, path = runs.back()]() {
+        std::ofstream run(path, std::ios::binary | std::ios::trunc);
+        write_records(run, chunk.data(), count);
+      });
+    }
+
+    for (std::future<void>& write : writes) {
+      if (write.valid()) {
+        write.get();
+      }
+    }
+  } catch (...) {
+    // a failed read or write leaves no run files behind
+    for (std::future<void>& write : writes) {
+      if (write.valid()) {
+        write.wait();
+      }
+    }
+    for (const std::filesystem::path& run : runs) {
+      std::error_code ignored;
+      std::filesystem::remove(run, ignored);
+    }
+    throw;
+  }
+
+  return runs;
+}
+
+template <typename Record>
+ExternalSortStats external_sort(
+  const std::filesystem::path& input,
+  const std::filesystem::path& output,
+  std::size_t memory_budget,
+  std::size_t fan_in,
+  const std::filesystem::path& temp_directory = std::filesystem::temp_directory_path()
+) {
+  static_assert(std::is_trivially_copyable_v<Record>, "records are read and written as raw bytes");
+
+  fan_in = std::max<std::size_t>(fan_in, 2);
+  std::string prefix = output.filename().string();
+  ExternalSortStats stats;
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::filesystem::path> runs =
+    generate_runs<Record>(input, temp_directory, prefix, memory_budget, stats);
+  auto generated = std::chrono::steady_clock::now();
+  stats.runs = runs.size();
+
+  // every source and the output get two blocks
+  std::size_t block_size = std::max<std::size_t>(1, memory_budget / (2 * (fan_in + 1)) / sizeof(Record));
+
+  if (runs.empty()) {
+    std::ofstream(output, std::ios::binary | std::ios::trunc);
+  }
+
+  for (std::size_t pass = 1; !runs.empty(); ++pass) {
+    std::vector<std::filesystem::path> merged;
+
+    for (std::size_t i = 0; i < runs.size(); i += fan_in) {
+      std::vector<std::filesystem::path> group(
+        runs.begin() + i, runs.begin() + std::min(runs.size(), i + fan_in)
+      );
+
+      std::filesystem::path destination = runs.size() <= fan_in
+        ? output
+        : temp_directory / (prefix + ".run" + std::to_string(pass) + '.' + std::to_string(merged.size()));
+
+      merge_run_files<Record>(group, destination, block_size);
+      merged.push_back(destination);
+
+      for (const std::filesystem::path& run : group) {
+        std::filesystem::remove(run);
+      }
+    }
+
+    ++stats.merge_passes;
+    if (runs.size() <= fan_in) {
+      break;
+    }
+    runs = merged;
+  }
+
+  auto finish = std::chrono::steady_clock::now();
+  stats.run_generation_ms = std::chrono::duration<double, std::milli>(generated - start).count();
+  stats.merge_ms = std::chrono::duration<double, std::milli>(finish - generated).count();
+
+  return stats;
+}
+
+#endif
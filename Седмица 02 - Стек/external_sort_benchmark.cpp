@@ -0,0 +1,86 @@
+#include "external_sort.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+struct Record {
+  std::uint64_t key;
+  std::uint64_t payload;
+
+  bool operator<(const Record& other) const {
+    return key < other.key;
+  }
+};
+
+void generate_file(const std::filesystem::path& path, std::size_t records) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  std::mt19937_64 generator(42);
+  std::vector<Record> block(1 << 16);
+
+  for (std::size_t written = 0; written < records; written += block.size()) {
+    std::size_t count = std::min(block.size(), records - written);
+    for (std::size_t i = 0; i < count; ++i) {
+      block[i] = {generator(), written + i};
+    }
+
+    file.write(reinterpret_cast<const char*>(block.data()), count * sizeof(Record));
+  }
+}
+
+bool is_sorted_file(const std::filesystem::path& path, std::size_t records) {
+  std::ifstream file(path, std::ios::binary);
+  std::vector<Record> block(1 << 16);
+  std::uint64_t previous = 0;
+  std::size_t total = 0;
+
+  while (std::size_t count = read_records(file, block.data(), block.size())) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (block[i].key < previous) {
+        return false;
+      }
+      previous = block[i].key;
+    }
+    total += count;
+  }
+
+  return total == records;
+}
+
+double megabytes_per_second(std::uintmax_t bytes, double ms) {
+  return bytes / (1024.0 * 1024.0) / (ms / 1000.0);
+}
+
+// usage: external_sort_benchmark [file MB] [memory budget MB] [fan-in] [directory]
+int main(int argc, char* argv[]) {
+  std::size_t file_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+  std::size_t budget_mb = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+  std::size_t fan_in = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 16;
+  std::filesystem::path directory = argc > 4 ? argv[4] : std::filesystem::temp_directory_path();
+
+  std::filesystem::path input = directory / "external_sort_input.bin";
+  std::filesystem::path output = directory / "external_sort_output.bin";
+  std::size_t records = file_mb * 1024 * 1024 / sizeof(Record);
+
+  generate_file(input, records);
+
+  ExternalSortStats stats = external_sort<Record>(input, output, budget_mb * 1024 * 1024, fan_in, directory);
+  bool sorted = is_sorted_file(output, records);
+
+  std::cout << std::fixed << std::setprecision(2)
+            << file_mb << "MB, budget " << budget_mb << "MB, fan-in " << fan_in << '\n'
+            << "run generation: " << stats.runs << " runs, " << stats.run_generation_ms << "ms, "
+            << megabytes_per_second(stats.bytes, stats.run_generation_ms) << "MB/s\n"
+            << "merge: " << stats.merge_passes << " passes, " << stats.merge_ms << "ms, "
+            << megabytes_per_second(stats.bytes * stats.merge_passes, stats.merge_ms) << "MB/s\n"
+            << (sorted ? "sorted" : "NOT SORTED") << '\n';
+
+  std::filesystem::remove(input);
+  std::filesystem::remove(output);
+  return 0;
+}
@@ -1,54 +1,64 @@
 #ifndef LINKED_STACK_HPP
 #define LINKED_STACK_HPP
 
+#include "node_pool.hpp"
 #include "stack.hpp"
+#include <type_traits>
 #include <utility>
 
-template <typename T>
+// with Pooled the nodes come from a NodePool owned by the stack instead of new/delete
+template <typename T, bool Pooled = false>
 class LinkedStack : public Stack<T> {
 public:
   LinkedStack() : top(nullptr) {}
-  LinkedStack(const LinkedStack<T>& other) : top(nullptr) {
+  LinkedStack(const LinkedStack& other) : top(nullptr) {
     if (other.empty()) {
       return;
     }
 
-    top = new Node(other.top->data);
+    top = nodes.create(nullptr, other.top->data);
     Node *next = other.top->next;
     Node* current = top;
 
     while (next) {
-      current = current->next = new Node(next->data);
+      current = current->next = nodes.create(nullptr, next->data);
       next = next->next;
     }
   }
-  LinkedStack(LinkedStack<T>&& other)
-    : top(std::exchange(other.top, nullptr)) {}
+  LinkedStack(LinkedStack&& other)
+    : top(std::exchange(other.top, nullptr)), nodes(std::move(other.nodes)) {}
   ~LinkedStack() {
-    while (!empty()) {
-      pop();
-    }
+    clear();
   }
-  LinkedStack<T>& operator=(const LinkedStack<T>& other) {
-    LinkedStack<T> copy(other);
+  LinkedStack& operator=(const LinkedStack& other) {
+    LinkedStack copy(other);
     swap(copy);
     return *this;
   }
-  LinkedStack<T>& operator=(LinkedStack<T>&& other) {
-    LinkedStack<T> copy(std::move(other));
+  LinkedStack& operator=(LinkedStack&& other) {
+    LinkedStack copy(std::move(other));
     swap(copy);
     return *this;
   }
 
   void push(const T& element) {
-    top = new Node(element, top);
+    top = nodes.create(top, element);
+  }
+
+  void push(T&& element) {
+    top = nodes.create(top, std::move(element));
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    top = nodes.create(top, std::forward<Args>(args)...);
   }
 
   T pop() {
-    T result = top->data;
+    T result = std::move(top->data);
     Node* next = top->next;
 
-    delete top;
+    nodes.destroy(top);
 
     top = next;
     return result;
@@ -66,20 +76,46 @@ public:
     return !top;
   }
 
+  // destroys the elements in place instead of moving each one out through pop()
+  void clear() {
+    if constexpr (Nodes::RELEASES_IN_BULK) {
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (Node* node = top; node; node = node->next) {
+          node->data.~T();
+        }
+      }
+    } else {
+      while (top) {
+        nodes.destroy(std::exchange(top, top->next));
+      }
+    }
+
+    top = nullptr;
+    nodes.release();
+  }
+
 private:
   struct Node {
     T data;
     Node* next;
 
-    Node(const T& data, Node* next = nullptr) 
-      : data(data), next(next) {}
+    template <typename... Args>
+    Node(Node* next, Args&&... args)
+      : data(std::forward<Args>(args)...), next(next) {}
   };
 
+  using Nodes = std::conditional_t<Pooled, NodePool<Node>, HeapNodes<Node>>;
+
   Node* top;
+  Nodes nodes;
 
-  void swap(LinkedStack<T>& other) {
+  void swap(LinkedStack& other) {
     std::swap(top, other.top);
+    std::swap(nodes, other.nodes);
   }
 };
 
-#endif
\ No newline at end of file
+template <typename T>
+using PooledLinkedStack = LinkedStack<T, true>;
+
+#endif
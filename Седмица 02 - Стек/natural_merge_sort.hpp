@@ -0,0 +1,307 @@
+#ifndef NATURAL_MERGE_SORT_HPP
+#define NATURAL_MERGE_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// A TimSort-like stable merge sort. The input is split into its natural ascending
+// and (reversed) strictly descending runs, short runs are extended with binary
+// insertion sort, and the runs are merged bottom-up from an explicit run stack.
+// The only allocation is the n / 2 scratch buffer used by every merge.
+
+constexpr std::size_t MIN_GALLOP = 7;
+// enough for 2^64 elements, since the run lengths grow at least like Fibonacci numbers
+constexpr std::size_t MAX_RUNS = 128;
+
+// the first position in [begin, end) for which before() does not hold - probes
+// 1, 2, 4, ... elements from begin, then binary searches the last interval
+template <typename T, typename Before>
+T* gallop(T* begin, T* end, Before before) {
+  std::ptrdiff_t size = end - begin, low = 0, high = 1;
+
+  while (high <= size && before(begin[high - 1])) {
+    low = high;
+    high *= 2;
+  }
+  high = std::min(high, size);
+
+  while (low < high) {
+    std::ptrdiff_t middle = low + (high - low) / 2;
+    if (before(begin[middle])) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return begin + low;
+}
+
+// the mirror of gallop - the start of the longest suffix of [begin, end) for which after() holds
+template <typename T, typename After>
+T* gallop_back(T* begin, T* end, After after) {
+  std::ptrdiff_t size = end - begin, low = 0, high = 1;
+
+  while (high <= size && after(*(end - high))) {
+    low = high;
+    high *= 2;
+  }
+  high = std::min(high, size);
+
+  while (low < high) {
+    std::ptrdiff_t middle = low + (high - low + 1) / 2;
+    if (after(*(end - middle))) {
+      low = middle;
+    } else {
+      high = middle - 1;
+    }
+  }
+
+  return end - low;
+}
+
+inline std::size_t min_run_length(std::size_t size) {
+  std::size_t remainder = 0;
+  while (size >= 64) {
+    remainder |= size & 1;
+    size >>= 1;
+  }
+
+  return size + remainder;
+}
+
+// length of the run starting at begin; a strictly descending run is reversed in place
+template <typename T>
+std::size_t count_run(T* begin, T* end) {
+  T* iter = begin + 1;
+  if (iter == end) {
+    return 1;
+  }
+
+  if (*iter < *begin) {
+    while (iter + 1 != end && *(iter + 1) < *iter) {
+      ++iter;
+    }
+    std::reverse(begin, iter + 1);
+  } else {
+    while (iter + 1 != end && !(*(iter + 1) < *iter)) {
+      ++iter;
+    }
+  }
+
+  return iter + 1 - begin;
+}
+
+// [begin, sorted) is already sorted
+template <typename T>
+void binary_insertion_sort(T* begin, T* sorted, T* end) {
+  for (; sorted != end; ++sorted) {
+    T value = std::move(*sorted);
+    T* position = std::upper_bound(begin, sorted, value);
+
+    std::move_backward(position, sorted, sorted + 1);
+    *position = std::move(value);
+  }
+}
+
+// merges the adjacent runs [left, right) and [right, end) when the left one is shorter;
+// the left run is moved to the buffer and the merge goes front to back
+template <typename T>
+void merge_low(T* left, T* right, T* end, T* buffer) {
+  T* out = left;
+  T* left_end = std::move(left, right, buffer);
+  left = buffer;
+
+  while (left != left_end && right != end) {
+    std::size_t left_wins = 0, right_wins = 0;
+
+    while (left != left_end && right != end && left_wins < MIN_GALLOP && right_wins < MIN_GALLOP) {
+      if (*right < *left) {
+        *out++ = std::move(*right++);
+        ++right_wins;
+        left_wins = 0;
+      } else {
+        *out++ = std::move(*left++);
+        ++left_wins;
+        right_wins = 0;
+      }
+    }
+
+    // one side keeps winning - copy whole stretches found by galloping
+    while (left != left_end && right != end) {
+      const T& next_right = *right;
+      T* left_stop = gallop(left, left_end, [&next_right](const T& x) { return !(next_right < x); });
+      std::size_t left_count = left_stop - left;
+      out = std::move(left, left_stop, out);
+      left = left_stop;
+
+      if (left == left_end) {
+        break;
+      }
+
+      const T& next_left = *left;
+      T* right_stop = gallop(right, end, [&next_left](const T& x) { return x < next_left; });
+      std::size_t right_count = right_stop - right;
+      out = std::move(right, right_stop, out);
+      right = right_stop;
+
+      if (left_count < MIN_GALLOP && right_count < MIN_GALLOP) {
+        break;
+      }
+    }
+  }
+
+  // whatever is left of the right run is already in place
+  std::move(left, left_end, out);
+}
+
+// merges the adjacent runs [begin, left) and [left, right) when the right one is shorter;
+// the right run is moved to the buffer and the merge goes back to front
+template <typename T>
+void merge_high(T* begin, T* left, T* right, T* buffer) {
+  T* out = right;
+  T* right_begin = buffer;
+  right = std::move(left, right, buffer);
+
+  while (left != begin && right != right_begin) {
+    std::size_t left_wins = 0, right_wins = 0;
+
+    while (left != begin && right != right_begin && left_wins < MIN_GALLOP && right_wins < MIN_GALLOP) {
+      if (*(right - 1) < *(left - 1)) {
+        *--out = std::move(*--left);
+        ++left_wins;
+        right_wins = 0;
+      } else {
+        *--out = std::move(*--right);
+        ++right_wins;
+        left_wins = 0;
+      }
+    }
+
+    while (left != begin && right != right_begin) {
+      const T& last_right = *(right - 1);
+      T* left_stop = gallop_back(begin, left, [&last_right](const T& x) { return last_right < x; });
+      std::size_t left_count = left - left_stop;
+      out = std::move_backward(left_stop, left, out);
+      left = left_stop;
+
+      if (left == begin) {
+        break;
+      }
+
+      const T& last_left = *(left - 1);
+      T* right_stop = gallop_back(right_begin, right, [&last_left](const T& x) { return !(x < last_left); });
+      std::size_t right_count = right - right_stop;
+      out = std::move_backward(right_stop, right, out);
+      right = right_stop;
+
+      if (left_count < MIN_GALLOP && right_count < MIN_GALLOP) {
+        break;
+      }
+    }
+  }
+
+  // whatever is left of the left run is already in place
+  std::move_backward(right_begin, right, out);
+}
+
+template <typename T>
+void merge_runs(T* begin, T* middle, T* end, T* buffer) {
+  // the prefix of the left run not greater than the first right element and the
+  // suffix of the right run not less than the last left element are in place
+  const T& first_right = *middle;
+  begin = gallop(begin, middle, [&first_right](const T& x) { return !(first_right < x); });
+  if (begin == middle) {
+    return;
+  }
+
+  const T& last_left = *(middle - 1);
+  end = gallop(middle, end, [&last_left](const T& x) { return x < last_left; });
+
+  if (middle - begin <= end - middle) {
+    merge_low(begin, middle, end, buffer);
+  } else {
+    merge_high(begin, middle, end, buffer);
+  }
+}
+
+template <typename T>
+struct Run {
+  T* begin;
+  std::size_t length;
+};
+
+template <typename T>
+void merge_at(Run<T>* runs, std::size_t& runs_count, std::size_t index, T* buffer) {
+  Run<T>& left = runs[index];
+  const Run<T>& right = runs[index + 1];
+
+  merge_runs(left.begin, right.begin, right.begin + right.length, buffer);
+  left.length += right.length;
+
+  if (index + 3 == runs_count) {
+    runs[index + 1] = runs[index + 2];
+  }
+  --runs_count;
+}
+
+// keeps the run lengths on the stack growing faster than Fibonacci numbers, so the
+// merges stay balanced and the stack stays logarithmic
+template <typename T>
+void collapse_runs(Run<T>* runs, std::size_t& runs_count, T* buffer) {
+  while (runs_count > 1) {
+    std::size_t n = runs_count - 2;
+
+    if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+        (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+      if (runs[n - 1].length < runs[n + 1].length) {
+        --n;
+      }
+    } else if (runs[n].length > runs[n + 1].length) {
+      break;
+    }
+
+    merge_at(runs, runs_count, n, buffer);
+  }
+}
+
+template <typename T>
+void natural_merge_sort(T* begin, T* end) {
+  std::size_t size = end - begin;
+  if (size < 2) {
+    return;
+  }
+
+  std::vector<T> buffer(size / 2);
+  std::size_t min_run = min_run_length(size);
+
+  Run<T> runs[MAX_RUNS];
+  std::size_t runs_count = 0;
+
+  for (T* iter = begin; iter != end;) {
+    std::size_t length = count_run(iter, end);
+
+    if (length < min_run) {
+      std::size_t extended = std::min<std::size_t>(min_run, end - iter);
+      binary_insertion_sort(iter, iter + length, iter + extended);
+      length = extended;
+    }
+
+    runs[runs_count++] = {iter, length};
+    collapse_runs(runs, runs_count, buffer.data());
+    iter += length;
+  }
+
+  while (runs_count > 1) {
+    std::size_t n = runs_count - 2;
+    if (n > 0 && runs[n - 1].length < runs[n + 1].length) {
+      --n;
+    }
+
+    merge_at(runs, runs_count, n, buffer.data());
+  }
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include "benchmark.hpp"
+#include "merge_sort.hpp"
+#include "natural_merge_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// log timestamps: mostly increasing, with entries delayed by up to a few positions
+// and the occasional late batch from a lagging source
+std::vector<long long> generate_log(std::size_t size, std::mt19937& generator) {
+  std::vector<long long> result(size);
+  std::uniform_int_distribution<int> jitter(-20, 20), chance(0, 999);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = 1000 * static_cast<long long>(i) + jitter(generator);
+
+    if (chance(generator) == 0 && i > 100000) {
+      result[i] -= 100000000;
+    }
+  }
+
+  for (std::size_t i = 0; i + 1 < size; i += 2) {
+    if (chance(generator) < 100) {
+      std::swap(result[i], result[i + 1]);
+    }
+  }
+
+  return result;
+}
+
+void run(const std::string& name, const std::vector<long long>& input) {
+  std::vector<long long> data;
+
+  data = input;
+  double classic = measure([&data]() { merge_sort(data.data(), data.data() + data.size()); });
+
+  data = input;
+  double natural = measure([&data]() { natural_merge_sort(data.data(), data.data() + data.size()); });
+  bool sorted = std::is_sorted(data.begin(), data.end());
+
+  data = input;
+  double standard = measure([&data]() { std::stable_sort(data.begin(), data.end()); });
+
+  std::cout << std::setw(14) << name
+            << std::setw(12) << std::fixed << std::setprecision(2) << classic << "ms"
+            << std::setw(12) << natural << "ms"
+            << std::setw(12) << standard << "ms"
+            << (sorted ? "" : "  NOT SORTED") << '\n';
+}
+
+// usage: natural_merge_sort_benchmark [size]
+int main(int argc, char* argv[]) {
+  std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::mt19937 generator(42);
+
+  std::cout << std::setw(14) << "input"
+            << std::setw(14) << "merge_sort"
+            << std::setw(14) << "natural"
+            << std::setw(14) << "stable_sort" << '\n';
+
+  std::vector<long long> log = generate_log(size, generator);
+  run("nearly sorted", log);
+
+  std::vector<long long> appended(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    appended[i] = i < size - size / 100 ? i : generator();
+  }
+  run("sorted + tail", appended);
+
+  std::reverse(appended.begin(), appended.end());
+  run("descending", appended);
+
+  std::vector<long long> random(size);
+  std::generate(random.begin(), random.end(), generator);
+  run("random", random);
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// the default node allocation - one new/delete per node
+template <typename Node>
+class HeapNodes {
+public:
+  template <typename... Args>
+  Node* create(Args&&... args) {
+    return new Node(std::forward<Args>(args)...);
+  }
+
+  void destroy(Node* node) {
+    delete node;
+  }
+
+  // the nodes are owned individually, there is nothing to release in bulk
+  static constexpr bool RELEASES_IN_BULK = false;
+
+  void release() {}
+};
+
+// Carves nodes out of slabs of SlabSize nodes. Destroyed nodes are recycled through
+// an intrusive free list threaded through their own storage, so a steady push/pop
+// pattern stops allocating once the pool has warmed up. release() frees all slabs at
+// once - the nodes in them must have been destroyed (or be trivially destructible).
+template <typename Node, std::size_t SlabSize = 256>
+class NodePool {
+public:
+  NodePool() : free_list(nullptr), slabs(nullptr), used(SlabSize) {}
+  NodePool(const NodePool&) = delete;
+  NodePool(NodePool&& other)
+    : free_list(std::exchange(other.free_list, nullptr)),
+      slabs(std::exchange(other.slabs, nullptr)),
+      used(std::exchange(other.used, SlabSize)) {}
+  ~NodePool() {
+    release();
+  }
+  NodePool& operator=(const NodePool&) = delete;
+  NodePool& operator=(NodePool&& other) {
+    NodePool copy(std::move(other));
+    swap(copy);
+    return *this;
+  }
+
+  template <typename... Args>
+  Node* create(Args&&... args) {
+    return new (allocate()) Node(std::forward<Args>(args)...);
+  }
+
+  void destroy(Node* node) {
+    node->~Node();
+
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next_free = free_list;
+    free_list = slot;
+  }
+
+  static constexpr bool RELEASES_IN_BULK = true;
+
+  void release() {
+    while (slabs) {
+      delete std::exchange(slabs, slabs->next);
+    }
+
+    free_list = nullptr;
+    used = SlabSize;
+  }
+
+  void swap(NodePool& other) {
+    std::swap(free_list, other.free_list);
+    std::swap(slabs, other.slabs);
+    std::swap(used, other.used);
+  }
+
+private:
+  union Slot {
+    Slot* next_free;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  struct Slab {
+    Slab* next;
+    Slot slots[SlabSize];
+  };
+
+  Slot* free_list;
+  Slab* slabs;
+  // slots handed out from the newest slab
+  std::size_t used;
+
+  void* allocate() {
+    if (free_list) {
+      return std::exchange(free_list, free_list->next_free)->storage;
+    }
+
+    if (used == SlabSize) {
+      Slab* slab = new Slab;
+      slab->next = slabs;
+      slabs = slab;
+      used = 0;
+    }
+
+    return slabs->slots[used++].storage;
+  }
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+#include "linked_stack.hpp"
+#include "merge_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// every allocation of the program goes through here, so it can be counted
+std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (void* memory = std::malloc(size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+template <typename StateStack>
+void run(const std::string& name, const std::vector<int>& input) {
+  std::vector<int> data = input;
+
+  std::size_t allocations_before = allocations;
+  double time = measure([&data]() {
+    merge_sort<int, StateStack>(data.data(), data.data() + data.size());
+  });
+  std::size_t sort_allocations = allocations - allocations_before;
+
+  // the same push/pop traffic as merge_sort without the merging, to see the stack alone
+  allocations_before = allocations;
+  double stack_time = measure([&input]() {
+    StateStack stack;
+    int* begin = const_cast<int*>(input.data());
+    stack.push(State<int>(begin, begin + input.size()));
+
+    while (!stack.empty()) {
+      State<int> current = stack.pop();
+      int* middle = current.begin + (current.end - current.begin) / 2;
+
+      if (!current.merge && current.end - current.begin > 1) {
+        stack.push(State<int>(current.begin, current.end, true));
+        stack.push(State<int>(middle, current.end));
+        stack.push(State<int>(current.begin, middle));
+      }
+    }
+  });
+  std::size_t stack_allocations = allocations - allocations_before;
+  std::size_t operations = 2 * (3 * input.size() - 2);
+
+  std::cout << std::setw(18) << name
+            << std::setw(12) << sort_allocations
+            << std::setw(12) << std::fixed << std::setprecision(2) << time << "ms"
+            << std::setw(14) << stack_allocations
+            << std::setw(12) << stack_time * 1e6 / operations << "ns"
+            << (std::is_sorted(data.begin(), data.end()) ? "" : "  NOT SORTED") << '\n';
+}
+
+// usage: node_pool_benchmark [size]
+int main(int argc, char* argv[]) {
+  std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+  std::vector<int> input(size);
+  std::mt19937 generator(42);
+  std::generate(input.begin(), input.end(), generator);
+
+  std::cout << "merge_sort of " << size << " random ints\n"
+            << std::setw(18) << "state stack"
+            << std::setw(12) << "allocs"
+            << std::setw(14) << "sort time"
+            << std::setw(14) << "stack allocs"
+            << std::setw(14) << "per push/pop" << '\n';
+
+  run<LinkedStack<State<int>>>("LinkedStack", input);
+  run<PooledLinkedStack<State<int>>>("PooledLinkedStack", input);
+
+  return 0;
+}
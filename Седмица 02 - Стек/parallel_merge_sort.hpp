@@ -0,0 +1,112 @@
+#ifndef PARALLEL_MERGE_SORT_HPP
+#define PARALLEL_MERGE_SORT_HPP
+
+#include "../Седмица 01 - Сложност на алгоритми/thread_pool.hpp"
+#include "merge_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// below these sizes sorting and merging are done sequentially
+constexpr std::size_t PARALLEL_MERGE_SORT_CUTOFF = 1 << 15;
+constexpr std::size_t PARALLEL_MERGE_CUTOFF = 1 << 16;
+
+// co-ranking: how many of the first k elements of the stable merge of
+// [a, a + a_size) and [b, b + b_size) come from a
+template <typename T>
+std::size_t co_rank(std::size_t k, const T* a, std::size_t a_size, const T* b, std::size_t b_size) {
+  std::size_t low = k > b_size ? k - b_size : 0;
+  std::size_t high = std::min(k, a_size);
+
+  while (low < high) {
+    std::size_t i = low + (high - low + 1) / 2;
+
+    // a[i - 1] still precedes b[k - i] - take at least i elements from a
+    if (!(b[k - i] < a[i - 1])) {
+      low = i;
+    } else {
+      high = i - 1;
+    }
+  }
+
+  return low;
+}
+
+// stable sequential merge into a separate output range
+template <typename T>
+void merge_into(const T* a, const T* a_end, const T* b, const T* b_end, T* out) {
+  while (a != a_end && b != b_end) {
+    if (*b < *a) {
+      *out++ = *b++;
+    } else {
+      *out++ = *a++;
+    }
+  }
+
+  while (a != a_end) {
+    *out++ = *a++;
+  }
+
+  while (b != b_end) {
+    *out++ = *b++;
+  }
+}
+
+// merges [begin, middle) and [middle, end) through buffer; the output is cut into
+// pieces whose boundaries are found by co-ranking, so every piece is merged independently
+template <typename T>
+void parallel_merge(T* begin, T* middle, T* end, T* buffer, ThreadPool& pool) {
+  std::size_t size = end - begin;
+  std::size_t left_size = middle - begin, right_size = end - middle;
+  std::size_t pieces = (size + PARALLEL_MERGE_CUTOFF - 1) / PARALLEL_MERGE_CUTOFF;
+
+  TaskGroup merges;
+  for (std::size_t piece = 0; piece < pieces; ++piece) {
+    pool.spawn(merges, [=]() {
+      std::size_t from = size * piece / pieces, to = size * (piece + 1) / pieces;
+      std::size_t i = co_rank(from, begin, left_size, middle, right_size);
+      std::size_t j = co_rank(to, begin, left_size, middle, right_size);
+
+      merge_into(begin + i, begin + j, middle + (from - i), middle + (to - j), buffer + from);
+    });
+  }
+  pool.wait(merges);
+
+  // the pieces read from all over [begin, end), so copy back only after all of them finish
+  TaskGroup copies;
+  for (std::size_t piece = 0; piece < pieces; ++piece) {
+    pool.spawn(copies, [=]() {
+      std::size_t from = size * piece / pieces, to = size * (piece + 1) / pieces;
+      std::copy(buffer + from, buffer + to, begin + from);
+    });
+  }
+  pool.wait(copies);
+}
+
+template <typename T>
+void parallel_merge_sort(T* begin, T* end, T* buffer, ThreadPool& pool) {
+  std::size_t size = end - begin;
+  if (size <= PARALLEL_MERGE_SORT_CUTOFF) {
+    merge_sort(begin, end);
+    return;
+  }
+
+  T* middle = begin + size / 2;
+
+  TaskGroup group;
+  pool.spawn(group, [=, &pool]() {
+    parallel_merge_sort(begin, middle, buffer, pool);
+  });
+  parallel_merge_sort(middle, end, buffer + size / 2, pool);
+  pool.wait(group);
+
+  parallel_merge(begin, middle, end, buffer, pool);
+}
+
+template <typename T>
+void parallel_merge_sort(T* begin, T* end, ThreadPool& pool) {
+  std::vector<T> buffer(end - begin);
+  parallel_merge_sort(begin, end, buffer.data(), pool);
+}
+
+#endif
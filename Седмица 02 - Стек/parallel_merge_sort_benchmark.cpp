@@ -0,0 +1,46 @@
+#include "benchmark.hpp"
+#include "merge_sort.hpp"
+#include "parallel_merge_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// usage: parallel_merge_sort_benchmark [size]
+int main(int argc, char* argv[]) {
+  std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+  std::vector<int> input(size);
+  std::mt19937 generator(42);
+  std::generate(input.begin(), input.end(), generator);
+
+  std::vector<int> data = input;
+  double sequential = measure([&data]() { merge_sort(data.data(), data.data() + data.size()); });
+  std::cout << "merge_sort, " << size << " random ints: "
+            << std::fixed << std::setprecision(2) << sequential << "ms\n";
+
+  std::cout << std::setw(8) << "threads"
+            << std::setw(14) << "time"
+            << std::setw(10) << "speedup"
+            << std::setw(10) << "steals" << '\n';
+
+  for (unsigned threads : {1, 2, 4, 8, 16, 32}) {
+    ThreadPool pool(threads);
+    data = input;
+
+    double time = measure([&data, &pool]() {
+      parallel_merge_sort(data.data(), data.data() + data.size(), pool);
+    });
+
+    std::cout << std::setw(8) << threads
+              << std::setw(12) << time << "ms"
+              << std::setw(9) << sequential / time << 'x'
+              << std::setw(10) << pool.steal_count()
+              << (std::is_sorted(data.begin(), data.end()) ? "" : "  NOT SORTED") << '\n';
+  }
+
+  return 0;
+}
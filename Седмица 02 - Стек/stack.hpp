@@ -1,16 +1,26 @@
 #ifndef STACK_HPP
 #define STACK_HPP
 
+#include <utility>
+
 template <typename T>
 class Stack {
 public:
   virtual void push(const T&) = 0;
+  virtual void push(T&&) = 0;
+  // moves the top element out
   virtual T pop() = 0;
   virtual T& peek() = 0;
   virtual const T& peek() const = 0;
   virtual bool empty() const = 0;
 
+  // implementations hide this with one that constructs the element in place
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    push(T(std::forward<Args>(args)...));
+  }
+
   virtual ~Stack() = default;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,79 @@
+#include "array_stack.hpp"
+#include "benchmark.hpp"
+#include "linked_stack.hpp"
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+constexpr std::size_t OPERATIONS = 10000000;
+
+// pushes and pops all the values in one deep stack
+template <typename S, typename T>
+double deep(const std::vector<T>& values) {
+  return measure([&values]() {
+    S stack;
+    for (const T& value : values) {
+      stack.push(value);
+    }
+
+    while (!stack.empty()) {
+      T popped = stack.pop();
+      (void)popped;
+    }
+  });
+}
+
+// many short-lived stacks of 16 elements - the inline buffer never spills
+template <typename S, typename T>
+double shallow(const std::vector<T>& values) {
+  return measure([&values]() {
+    for (std::size_t i = 0; i + 16 <= values.size(); i += 16) {
+      S stack;
+      for (std::size_t j = i; j < i + 16; ++j) {
+        stack.push(values[j]);
+      }
+
+      while (!stack.empty()) {
+        T popped = stack.pop();
+        (void)popped;
+      }
+    }
+  });
+}
+
+double million_operations_per_second(double ms) {
+  return 2 * OPERATIONS / ms / 1000.0;
+}
+
+template <typename T>
+void run(const std::string& type_name, const std::vector<T>& values) {
+  std::cout << type_name << ", million push + pop per second\n"
+            << std::setw(24) << "stack" << std::setw(10) << "deep" << std::setw(10) << "shallow" << '\n';
+
+  auto report = [](const std::string& name, double deep_time, double shallow_time) {
+    std::cout << std::setw(24) << name
+              << std::setw(10) << std::fixed << std::setprecision(1) << million_operations_per_second(deep_time)
+              << std::setw(10) << million_operations_per_second(shallow_time) << '\n';
+  };
+
+  report("LinkedStack", deep<LinkedStack<T>>(values), shallow<LinkedStack<T>>(values));
+  report("ArrayStack", deep<ArrayStack<T>>(values), shallow<ArrayStack<T>>(values));
+  report("ArrayStack<T, 16>", deep<ArrayStack<T, 16>>(values), shallow<ArrayStack<T, 16>>(values));
+}
+
+int main() {
+  std::vector<int> numbers(OPERATIONS);
+  std::vector<std::string> strings(OPERATIONS);
+
+  for (std::size_t i = 0; i < OPERATIONS; ++i) {
+    numbers[i] = i;
+    strings[i] = "element #" + std::to_string(i) + (i % 2 ? " with a longer suffix" : "");
+  }
+
+  run("int", numbers);
+  run("std::string", strings);
+
+  return 0;
+}
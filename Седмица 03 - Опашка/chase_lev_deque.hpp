@@ -0,0 +1,127 @@
+#ifndef CHASE_LEV_DEQUE_HPP
+#define CHASE_LEV_DEQUE_HPP
+
+#include "concurrency.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Work-stealing deque (Chase, Lev; memory orders after Le, Pop, Cohen, Zappa Nardelli).
+// One owner thread pushes and pops at the bottom, any number of thieves steal at
+// the top. The owner only synchronises with thieves when they race for the last
+// element. The circular buffer doubles when full - the old buffers are kept until
+// the deque is destroyed, since a thief may still be reading from one.
+template <typename T>
+class ChaseLevDeque {
+  static_assert(std::is_trivially_copyable_v<T>, "the elements are read racily and must be plain values, e.g. pointers");
+
+public:
+  explicit ChaseLevDeque(std::size_t capacity = 64) : top(0), bottom(0) {
+    std::size_t size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+
+    rings.push_back(std::make_unique<Ring>(size));
+    ring.store(rings.back().get(), std::memory_order_relaxed);
+  }
+  ChaseLevDeque(const ChaseLevDeque&) = delete;
+  ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+  // owner
+  void push(T element) {
+    std::int64_t b = bottom.load(std::memory_order_relaxed);
+    std::int64_t t = top.load(std::memory_order_acquire);
+    Ring* current = ring.load(std::memory_order_relaxed);
+
+    if (b - t >= std::int64_t(current->capacity)) {
+      current = grow(current, t, b);
+    }
+
+    current->put(b, element);
+    bottom.store(b + 1, std::memory_order_release);
+  }
+
+  // owner: the most recently pushed element
+  bool pop(T& result) {
+    std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    Ring* current = ring.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    result = current->get(b);
+    if (t == b) {
+      // the last element - a thief may be taking it right now
+      bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+
+    return true;
+  }
+
+  // any thread: the oldest element; false when empty or when another thread won the race
+  bool steal(T& result) {
+    std::int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+      return false;
+    }
+
+    result = ring.load(std::memory_order_acquire)->get(t);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+  }
+
+  // a snapshot - other threads may change it right after
+  bool empty() const {
+    return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Ring {
+    const std::size_t capacity;
+    const std::size_t mask;
+    std::unique_ptr<std::atomic<T>[]> items;
+
+    explicit Ring(std::size_t capacity)
+      : capacity(capacity), mask(capacity - 1), items(new std::atomic<T>[capacity]) {}
+
+    T get(std::int64_t index) const {
+      return items[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(std::int64_t index, T element) {
+      items[index & mask].store(element, std::memory_order_relaxed);
+    }
+  };
+
+  alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> top;
+  alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom;
+  std::atomic<Ring*> ring;
+  // owner only: every buffer ever used, the last one is current
+  std::vector<std::unique_ptr<Ring>> rings;
+
+  Ring* grow(Ring* current, std::int64_t t, std::int64_t b) {
+    auto bigger = std::make_unique<Ring>(2 * current->capacity);
+    for (std::int64_t i = t; i < b; ++i) {
+      bigger->put(i, current->get(i));
+    }
+
+    rings.push_back(std::move(bigger));
+    ring.store(rings.back().get(), std::memory_order_release);
+    return rings.back().get();
+  }
+};
+
+#endif
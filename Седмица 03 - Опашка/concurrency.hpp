@@ -0,0 +1,63 @@
+#ifndef CONCURRENCY_HPP
+#define CONCURRENCY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// tells the core we are spinning, so the other hyperthread gets the pipeline
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// Sleeps while word still holds expected, at most timeout (negative - no limit).
+// Returns early when woken, on a spurious wakeup or when the word already changed,
+// so the caller always checks its condition again.
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, std::chrono::nanoseconds timeout) {
+#ifdef __linux__
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex needs a plain 32 bit word");
+
+  timespec limit;
+  timespec* limit_pointer = nullptr;
+  if (timeout.count() >= 0) {
+    limit.tv_sec = timeout.count() / 1000000000;
+    limit.tv_nsec = timeout.count() % 1000000000;
+    limit_pointer = &limit;
+  }
+
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, limit_pointer, nullptr, 0);
+#else
+  // no futex - poll the word instead
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (word.load() == expected && (timeout.count() < 0 || std::chrono::steady_clock::now() < deadline)) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+#endif
+}
+
+inline void futex_wake(std::atomic<std::uint32_t>& word, bool all) {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, nullptr, nullptr, 0);
+#else
+  (void)word;
+  (void)all;
+#endif
+}
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef GRID_SEARCH_HPP
+#define GRID_SEARCH_HPP
+
+#include "../Седмица 01 - Сложност на алгоритми/thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// x is the row and y the column, as in matrix[x][y]
+struct Point {
+  int x, y;
+
+  bool operator==(const Point& other) const {
+    return x == other.x && y == other.y;
+  }
+};
+
+constexpr Point steps[] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+
+// Occupancy map with one bit per cell, stored row by row
+class GridMap {
+public:
+  GridMap(std::size_t rows, std::size_t columns)
+    : rows(rows), columns(columns), words_per_row((columns + 63) / 64), bits(rows * words_per_row, 0) {}
+
+  // true in the matrix is an obstacle; the rows may be of any (equal) length
+  explicit GridMap(const std::vector<std::vector<bool>>& matrix)
+    : GridMap(matrix.size(), matrix.empty() ? 0 : matrix[0].size()) {
+    for (std::size_t x = 0; x < rows; ++x) {
+      for (std::size_t y = 0; y < columns; ++y) {
+        set_blocked(x, y, matrix[x][y]);
+      }
+    }
+  }
+
+  std::size_t get_rows() const {
+    return rows;
+  }
+
+  std::size_t get_columns() const {
+    return columns;
+  }
+
+  bool in_bounds(int x, int y) const {
+    return x >= 0 && std::size_t(x) < rows && y >= 0 && std::size_t(y) < columns;
+  }
+
+  // inside the map and not an obstacle
+  bool is_free(int x, int y) const {
+    return in_bounds(x, y) && !(bits[x * words_per_row + (y >> 6)] >> (y & 63) & 1);
+  }
+
+  bool is_free(const Point& point) const {
+    return is_free(point.x, point.y);
+  }
+
+  void set_blocked(std::size_t x, std::size_t y, bool blocked) {
+    std::uint64_t& word = bits[x * words_per_row + (y >> 6)];
+    std::uint64_t bit = std::uint64_t(1) << (y & 63);
+    word = blocked ? word | bit : word & ~bit;
+  }
+
+  std::size_t index(const Point& point) const {
+    return std::size_t(point.x) * columns + point.y;
+  }
+
+private:
+  std::size_t rows, columns, words_per_row;
+  std::vector<std::uint64_t> bits;
+};
+
+// one bit per cell of a map, cleared a word at a time between searches
+class CellSet {
+public:
+  void reset(std::size_t cells) {
+    words.assign((cells + 63) / 64, 0);
+  }
+
+  bool contains(std::size_t cell) const {
+    return words[cell >> 6] >> (cell & 63) & 1;
+  }
+
+  void insert(std::size_t cell) {
+    words[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+  }
+
+private:
+  std::vector<std::uint64_t> words;
+};
+
+enum class SearchAlgorithm {
+  BFS,
+  BIDIRECTIONAL_BFS,
+  A_STAR,
+  JUMP_POINT_SEARCH
+};
+
+struct PathQuery {
+  Point start, end;
+};
+
+// The shortest path lengths on one map over 4-connected moves. The search keeps a
+// reference to the map and its working memory between queries, so answering many
+// queries neither copies the map nor reallocates. Start and end must be free cells.
+class GridSearch {
+public:
+  explicit GridSearch(const GridMap& map) : map(map), expanded(0) {}
+
+  std::optional<unsigned> find(const Point& start, const Point& end, SearchAlgorithm algorithm) {
+    switch (algorithm) {
+      case SearchAlgorithm::BFS: return bfs(start, end);
+      case SearchAlgorithm::BIDIRECTIONAL_BFS: return bidirectional_bfs(start, end);
+      case SearchAlgorithm::A_STAR: return a_star(start, end);
+      default: return jump_point_search(start, end);
+    }
+  }
+
+  // level by level, a cell is marked when it is enqueued so it is enqueued only once
+  std::optional<unsigned> bfs(const Point& start, const Point& end) {
+    expanded = 0;
+    if (!map.is_free(start) || !map.is_free(end)) {
+      return std::nullopt;
+    }
+    if (start == end) {
+      return 0;
+    }
+
+    visited.reset(map.get_rows() * map.get_columns());
+    visited.insert(map.index(start));
+    frontier.assign(1, start);
+
+    for (unsigned distance = 1; !frontier.empty(); ++distance) {
+      next.clear();
+      expanded += frontier.size();
+
+      for (const Point& current : frontier) {
+        for (const Point& step : steps) {
+          Point neighbour{current.x + step.x, current.y + step.y};
+          if (!map.is_free(neighbour) || visited.contains(map.index(neighbour))) {
+            continue;
+          }
+
+          if (neighbour == end) {
+            return distance;
+          }
+
+          visited.insert(map.index(neighbour));
+          next.push_back(neighbour);
+        }
+      }
+
+      std::swap(frontier, next);
+    }
+
+    return std::nullopt;
+  }
+
+  // Both ends grow a level at a time, always the smaller frontier. Before a level is
+  // expanded nothing is visited from both sides, so a cell seen from the other side
+  // is on its last level - the path is both depths plus the step in between.
+  std::optional<unsigned> bidirectional_bfs(const Point& start, const Point& end) {
+    expanded = 0;
+    if (!map.is_free(start) || !map.is_free(end)) {
+      return std::nullopt;
+    }
+    if (start == end) {
+      return 0;
+    }
+
+    visited.reset(map.get_rows() * map.get_columns());
+    other_visited.reset(map.get_rows() * map.get_columns());
+    visited.insert(map.index(start));
+    other_visited.insert(map.index(end));
+    frontier.assign(1, start);
+    other_frontier.assign(1, end);
+    unsigned depth = 0, other_depth = 0;
+
+    while (!frontier.empty() && !other_frontier.empty()) {
+      bool forward = frontier.size() <= other_frontier.size();
+      std::vector<Point>& current_frontier = forward ? frontier : other_frontier;
+      CellSet& own = forward ? visited : other_visited;
+      const CellSet& other = forward ? other_visited : visited;
+
+      next.clear();
+      expanded += current_frontier.size();
+
+      for (const Point& current : current_frontier) {
+        for (const Point& step : steps) {
+          Point neighbour{current.x + step.x, current.y + step.y};
+          if (!map.is_free(neighbour) || own.contains(map.index(neighbour))) {
+            continue;
+          }
+
+          if (other.contains(map.index(neighbour))) {
+            return depth + other_depth + 1;
+          }
+
+          own.insert(map.index(neighbour));
+          next.push_back(neighbour);
+        }
+      }
+
+      std::swap(current_frontier, next);
+      ++(forward ? depth : other_depth);
+    }
+
+    return std::nullopt;
+  }
+
+  // A* with the Manhattan distance. The estimates are small integers, so the open
+  // list is a bucket per estimate instead of a heap; within a bucket the deepest
+  // node goes first. A cell is closed when it is taken out - the heuristic is
+  // consistent, so that is its shortest distance.
+  std::optional<unsigned> a_star(const Point& start, const Point& end) {
+    return best_first(start, end, false);
+  }
+
+  // Jump point search for 4-connected grids. Among the shortest paths only the ones
+  // that move along a row before moving along a column are searched: from a cell
+  // entered along a row the path may turn to the column, from a cell entered along a
+  // column it may turn only where an obstacle behind forces it. Straight runs without
+  // such turns are skipped in one jump and only their ends go to the open list.
+  std::optional<unsigned> jump_point_search(const Point& start, const Point& end) {
+    return best_first(start, end, true);
+  }
+
+  // the cells taken out of the queue by the last search
+  std::size_t expanded_count() const {
+    return expanded;
+  }
+
+private:
+  struct Node {
+    Point point;
+    unsigned distance;
+    // the direction the node was entered in, zero for the start
+    Point direction;
+  };
+
+  const GridMap& map;
+  CellSet visited, other_visited;
+  std::vector<Point> frontier, other_frontier, next;
+  std::vector<std::vector<Node>> buckets;
+  std::size_t expanded;
+
+  static unsigned manhattan(const Point& a, const Point& b) {
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+  }
+
+  std::optional<unsigned> best_first(const Point& start, const Point& end, bool jump) {
+    expanded = 0;
+    if (!map.is_free(start) || !map.is_free(end)) {
+      return std::nullopt;
+    }
+
+    visited.reset(map.get_rows() * map.get_columns());
+    for (std::vector<Node>& bucket : buckets) {
+      bucket.clear();
+    }
+
+    unsigned lowest = manhattan(start, end);
+    auto push = [this, &end, lowest](const Node& node) {
+      std::size_t bucket = node.distance + manhattan(node.point, end) - lowest;
+      if (bucket >= buckets.size()) {
+        buckets.resize(bucket + 1);
+      }
+      buckets[bucket].push_back(node);
+    };
+
+    push({start, 0, {0, 0}});
+
+    for (std::size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+      while (!buckets[bucket].empty()) {
+        Node current = buckets[bucket].back();
+        buckets[bucket].pop_back();
+
+        std::size_t cell = map.index(current.point);
+        if (visited.contains(cell)) {
+          continue;
+        }
+        visited.insert(cell);
+        ++expanded;
+
+        if (current.point == end) {
+          return current.distance;
+        }
+
+        for (const Point& step : steps) {
+          if (jump) {
+            if (!is_canonical(current, step)) {
+              continue;
+            }
+
+            std::optional<Point> found = step.x ? jump_along_column(current.point, step.x, end) : jump_along_row(current.point, step.y, end);
+            if (found && !visited.contains(map.index(*found))) {
+              push({*found, current.distance + manhattan(current.point, *found), step});
+            }
+          } else {
+            Point neighbour{current.point.x + step.x, current.point.y + step.y};
+            if (map.is_free(neighbour) && !visited.contains(map.index(neighbour))) {
+              push({neighbour, current.distance + 1, step});
+            }
+          }
+        }
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  // whether a path entering node.point in node.direction continues with step
+  bool is_canonical(const Node& node, const Point& step) const {
+    const Point& direction = node.direction;
+    if (direction.x == 0 && direction.y == 0) {
+      return true;
+    }
+
+    // never straight back
+    if (step.x == -direction.x && step.y == -direction.y) {
+      return false;
+    }
+
+    // along a row: straight on or turning to the column
+    if (direction.x == 0) {
+      return true;
+    }
+
+    // along a column: straight on, or to the row only where the cell behind blocks the row-first path
+    if (step.x != 0) {
+      return true;
+    }
+    return !map.is_free(node.point.x - direction.x, node.point.y + step.y);
+  }
+
+  // the next cell of the column that the path may turn from, or the end
+  std::optional<Point> jump_along_column(Point point, int dx, const Point& end) const {
+    while (true) {
+      point.x += dx;
+      if (!map.is_free(point)) {
+        return std::nullopt;
+      }
+
+      if (point == end) {
+        return point;
+      }
+
+      for (int dy : {-1, 1}) {
+        if (map.is_free(point.x, point.y + dy) && !map.is_free(point.x - dx, point.y + dy)) {
+          return point;
+        }
+      }
+    }
+  }
+
+  // the next cell of the row from which a column jump finds something
+  std::optional<Point> jump_along_row(Point point, int dy, const Point& end) const {
+    while (true) {
+      point.y += dy;
+      if (!map.is_free(point)) {
+        return std::nullopt;
+      }
+
+      if (point == end || jump_along_column(point, 1, end) || jump_along_column(point, -1, end)) {
+        return point;
+      }
+    }
+  }
+};
+
+// answers all queries with one set of working memory, without copying the map
+inline std::vector<std::optional<unsigned>> find_shortest_paths(
+  const GridMap& map,
+  const std::vector<PathQuery>& queries,
+  SearchAlgorithm algorithm
+) {
+  std::vector<std::optional<unsigned>> result;
+  GridSearch search(map);
+
+  for (const PathQuery& query : queries) {
+    result.push_back(search.find(query.start, query.end, algorithm));
+  }
+
+  return result;
+}
+
+// the same, split between the threads of the pool - every task has its own working memory;
+// Pool is ThreadPool or WorkStealingPool
+template <typename Pool>
+std::vector<std::optional<unsigned>> find_shortest_paths(
+  const GridMap& map,
+  const std::vector<PathQuery>& queries,
+  SearchAlgorithm algorithm,
+  Pool& pool
+) {
+  std::vector<std::optional<unsigned>> result(queries.size());
+  std::size_t tasks = std::min(queries.size(), pool.thread_count());
+  TaskGroup group;
+
+  for (std::size_t task = 0; task < tasks; ++task) {
+    pool.spawn(group, [&, task]() {
+      GridSearch search(map);
+      for (std::size_t i = task; i < queries.size(); i += tasks) {
+        result[i] = search.find(queries[i].start, queries[i].end, algorithm);
+      }
+    });
+  }
+  pool.wait(group);
+
+  return result;
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "benchmark.hpp"
+#include "grid_search.hpp"
+#include "work_stealing_pool.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// A maze on a size x size grid: the cells with both coordinates odd are rooms and a
+// randomized depth-first search knocks out the walls between them, which gives one
+// path between any two rooms. Afterwards every remaining inner wall is removed with
+// the given probability, so the maze gets loops and more than one shortest path.
+GridMap generate_maze(int size, double shortcuts, std::mt19937& random) {
+  GridMap map(size, size);
+  for (int x = 0; x < size; ++x) {
+    for (int y = 0; y < size; ++y) {
+      map.set_blocked(x, y, true);
+    }
+  }
+
+  int rooms = (size - 1) / 2;
+  std::vector<bool> visited(std::size_t(rooms) * rooms, false);
+  std::vector<Point> stack = {{0, 0}};
+  visited[0] = true;
+  map.set_blocked(1, 1, false);
+
+  while (!stack.empty()) {
+    Point current = stack.back();
+    Point options[4];
+    int count = 0;
+
+    for (const Point& step : steps) {
+      Point next{current.x + step.x, current.y + step.y};
+      if (next.x >= 0 && next.x < rooms && next.y >= 0 && next.y < rooms && !visited[std::size_t(next.x) * rooms + next.y]) {
+        options[count++] = next;
+      }
+    }
+
+    if (count == 0) {
+      stack.pop_back();
+      continue;
+    }
+
+    Point next = options[random() % count];
+    visited[std::size_t(next.x) * rooms + next.y] = true;
+    map.set_blocked(current.x + next.x + 1, current.y + next.y + 1, false);
+    map.set_blocked(2 * next.x + 1, 2 * next.y + 1, false);
+    stack.push_back(next);
+  }
+
+  std::bernoulli_distribution knock_out(shortcuts);
+  for (int x = 1; x < size - 1; ++x) {
+    for (int y = 1 + x % 2; y < size - 1; y += 2) {
+      if (!map.is_free(x, y) && knock_out(random)) {
+        map.set_blocked(x, y, false);
+      }
+    }
+  }
+
+  return map;
+}
+
+// every cell is an obstacle with the given probability
+GridMap generate_random(int size, double density, std::mt19937& random) {
+  GridMap map(size, size);
+  std::bernoulli_distribution blocked(density);
+
+  for (int x = 0; x < size; ++x) {
+    for (int y = 0; y < size; ++y) {
+      map.set_blocked(x, y, blocked(random));
+    }
+  }
+
+  return map;
+}
+
+std::vector<PathQuery> generate_queries(const GridMap& map, std::size_t count, std::mt19937& random) {
+  std::uniform_int_distribution<int> row(0, map.get_rows() - 1), column(0, map.get_columns() - 1);
+  auto free_point = [&]() {
+    Point point;
+    do {
+      point = {row(random), column(random)};
+    } while (!map.is_free(point));
+    return point;
+  };
+
+  std::vector<PathQuery> queries;
+  for (std::size_t i = 0; i < count; ++i) {
+    Point start = free_point();
+    queries.push_back({start, free_point()});
+  }
+
+  return queries;
+}
+
+void report(const std::string& map_name, const GridMap& map, const std::vector<PathQuery>& queries, WorkStealingPool& pool) {
+  const std::pair<std::string, SearchAlgorithm> algorithms[] = {
+    {"bfs", SearchAlgorithm::BFS},
+    {"bidirectional bfs", SearchAlgorithm::BIDIRECTIONAL_BFS},
+    {"a*", SearchAlgorithm::A_STAR},
+    {"jump point search", SearchAlgorithm::JUMP_POINT_SEARCH},
+  };
+
+  std::cout << '\n' << map_name << '\n'
+            << std::setw(20) << "algorithm" << std::setw(14) << "ms/query"
+            << std::setw(16) << "expanded/query" << std::setw(16) << "batch, pool" << '\n';
+
+  std::vector<std::optional<unsigned>> expected;
+  GridSearch search(map);
+
+  for (const auto& [name, algorithm] : algorithms) {
+    std::vector<std::optional<unsigned>> result;
+    std::size_t expanded = 0;
+
+    double time = measure([&]() {
+      for (const PathQuery& query : queries) {
+        result.push_back(search.find(query.start, query.end, algorithm));
+        expanded += search.expanded_count();
+      }
+    });
+
+    std::vector<std::optional<unsigned>> parallel;
+    double parallel_time = measure([&]() {
+      parallel = find_shortest_paths(map, queries, algorithm, pool);
+    });
+
+    if (expected.empty()) {
+      expected = result;
+    }
+
+    std::cout << std::setw(20) << name << std::fixed << std::setprecision(1)
+              << std::setw(14) << time / queries.size()
+              << std::setw(16) << expanded / queries.size()
+              << std::setw(14) << parallel_time << "ms"
+              << (result == expected && parallel == expected ? "" : "  WRONG") << '\n';
+  }
+}
+
+// usage: grid_search_benchmark [size] [queries] [threads]
+int main(int argc, char* argv[]) {
+  int size = argc > 1 ? std::atoi(argv[1]) : 10000;
+  std::size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+  unsigned threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+
+  std::mt19937 random(42);
+  WorkStealingPool pool(threads);
+  std::cout << size << 'x' << size << " maps, " << queries << " queries between random free cells, "
+            << "batches on " << pool.thread_count() << " threads\n";
+
+  GridMap maze = generate_maze(size, 0, random);
+  report("perfect maze", maze, generate_queries(maze, queries, random), pool);
+
+  GridMap braided = generate_maze(size, 0.1, random);
+  report("maze with 10% of the walls removed", braided, generate_queries(braided, queries, random), pool);
+
+  GridMap open = generate_random(size, 0.3, random);
+  report("30% random obstacles", open, generate_queries(open, queries, random), pool);
+
+  return 0;
+}
@@ -1,4 +1,6 @@
+#include "grid_search.hpp"
 #include "queue_with_stacks.hpp"
+#include "sliding_window.hpp"
 #include <algorithm>
 #include <iostream>
 #include <iterator>
@@ -77,85 +79,19 @@ std::vector<unsigned> generate_hamming_numbers(unsigned n) {
   return result;
 }
 
-struct Point {
-  int x, y;
-};
-
-struct PositionWithDistance : Point {
-  unsigned distance;
-};
-
-constexpr Point steps[] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
-
-bool is_valid(
-  const std::vector<std::vector<bool>>& matrix,
-  const Point& current,
-  const Point& step
-) {
-  int x = current.x + step.x, y = current.y + step.y;
-
-  return x >= 0 && x < matrix.size() && 
-         y >= 0 && y < matrix.size() &&
-         !matrix[x][y];
-}
-
 std::optional<unsigned> find_shortest_path(
-  std::vector<std::vector<bool>>& matrix,
+  const std::vector<std::vector<bool>>& matrix,
   const Point& start,
   const Point& end
 ) {
-  std::queue<PositionWithDistance> queue;
-  queue.push({start.x, start.y, 0});
-
-  while (!queue.empty()) {
-    PositionWithDistance current = queue.front();
-    queue.pop();
-
-    matrix[current.x][current.y] = true;
-
-    for (const Point& step : steps) {
-      if (current.x + step.x == end.x && current.y + step.y == end.y) {
-        return current.distance + 1;
-      }
-
-      if(is_valid(matrix, current, step)) {
-        queue.push({ current.x + step.x, current.y + step.y, current.distance + 1 });
-      }
-    }
-  }
-
-  return std::nullopt;
+  GridMap map(matrix);
+  return GridSearch(map).bfs(start, end);
 }
 
 std::vector<int> find_first_negative(const std::vector<int>& arr, std::size_t n) {
   std::vector<int> result;
-  std::queue<std::size_t> window;
-
-  // seed first n-1 indices
-  for (std::size_t i = 0; i < n - 1; ++i) {
-    window.push(i);
-  }
-
-  for (std::size_t i = n-1; i < arr.size(); ++i) {
-    window.push(i);
-    
-    // too many elements in the queue
-    if (i - window.front() == n) {
-      window.pop();
-    }
-    
-    // move until the first index points to negative or empy
-    while (!window.empty() && arr[window.front()] >= 0) {
-      window.pop();
-    }
-    
-    // save 0 - all are positive
-    if (window.empty()) {
-      result.push_back(0);
-    } else {
-      result.push_back(arr[window.front()]);
-    } 
-  }
+  SlidingWindow<int, FirstNegative<int>> window(n);
+  window.push(arr.data(), arr.data() + arr.size(), std::back_inserter(result));
 
   return result;
 }
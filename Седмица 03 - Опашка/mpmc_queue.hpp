@@ -0,0 +1,263 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include "concurrency.hpp"
+#include "queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+// how many times a blocking call retries before it goes to sleep on the futex
+constexpr unsigned MPMC_SPIN_LIMIT = 128;
+
+// Bounded queue for any number of producers and consumers (Vyukov). Every slot
+// carries a sequence number that says whose turn it is: equal to the position -
+// free for the producer of that position, position + 1 - full for its consumer.
+// Producers and consumers claim positions with a compare_exchange on their own
+// counter and never touch the other side's counter.
+// The blocking calls spin for a while and then sleep on a futex word that the
+// other side bumps - full producers are the backpressure for fast producers.
+template <typename T>
+class MpmcQueue : public Queue<T> {
+public:
+  // the capacity is rounded up to a power of two so that a slot is position & mask
+  explicit MpmcQueue(std::size_t capacity)
+    : capacity(round_up_to_power_of_two(std::max<std::size_t>(capacity, 2))),
+      mask(this->capacity - 1),
+      slots(std::allocator<Slot>().allocate(this->capacity)) {
+    for (std::size_t i = 0; i < this->capacity; ++i) {
+      new (slots + i) Slot();
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+  ~MpmcQueue() {
+    std::size_t end = enqueue_position.load(std::memory_order_relaxed);
+    for (std::size_t position = dequeue_position.load(std::memory_order_relaxed); position != end; ++position) {
+      slots[position & mask].value()->~T();
+    }
+
+    std::destroy(slots, slots + capacity);
+    std::allocator<Slot>().deallocate(slots, capacity);
+  }
+
+  void enqueue(const T& element) {
+    enqueue_until(element, NO_TIMEOUT);
+  }
+
+  void enqueue(T&& element) {
+    enqueue_until(std::move(element), NO_TIMEOUT);
+  }
+
+  bool try_enqueue(const T& element) {
+    return try_emplace(element);
+  }
+
+  bool try_enqueue(T&& element) {
+    return try_emplace(std::move(element));
+  }
+
+  template <typename U, typename Rep, typename Period>
+  bool try_enqueue_for(U&& element, const std::chrono::duration<Rep, Period>& timeout) {
+    return enqueue_until(std::forward<U>(element), std::chrono::steady_clock::now() + timeout);
+  }
+
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+
+    while (true) {
+      Slot& slot = slots[position & mask];
+      std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      std::ptrdiff_t difference = std::ptrdiff_t(sequence - position);
+
+      if (difference == 0) {
+        if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          new (slot.storage) T(std::forward<Args>(args)...);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          notify(not_empty, empty_waiters);
+          return true;
+        }
+      } else if (difference < 0) {
+        // the slot still holds the element from a lap ago - full
+        return false;
+      } else {
+        position = enqueue_position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // blocks until there is an element and moves it into result
+  void dequeue(T& result) {
+    dequeue_until(result, NO_TIMEOUT);
+  }
+
+  // blocks until there is an element and drops it
+  void dequeue() {
+    wait_until([this]() {
+      return try_consume([](T&&) {});
+    }, not_empty, empty_waiters, NO_TIMEOUT);
+  }
+
+  bool try_dequeue(T& result) {
+    return try_consume([&result](T&& element) {
+      result = std::move(element);
+    });
+  }
+
+  template <typename Rep, typename Period>
+  bool try_dequeue_for(T& result, const std::chrono::duration<Rep, Period>& timeout) {
+    return dequeue_until(result, std::chrono::steady_clock::now() + timeout);
+  }
+
+  // only meaningful while a single consumer runs - blocks until the next element is there
+  T& first() {
+    Slot& slot = slots[dequeue_position.load(std::memory_order_relaxed) & mask];
+    wait_until([this, &slot]() {
+      return slot.sequence.load(std::memory_order_acquire) == dequeue_position.load(std::memory_order_relaxed) + 1;
+    }, not_empty, empty_waiters, NO_TIMEOUT);
+
+    return *slot.value();
+  }
+
+  const T& first() const {
+    return const_cast<MpmcQueue*>(this)->first();
+  }
+
+  // a snapshot - other threads may change it right after
+  bool empty() const {
+    std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+    return std::ptrdiff_t(slots[position & mask].sequence.load(std::memory_order_acquire) - (position + 1)) < 0;
+  }
+
+  std::size_t get_capacity() const {
+    return capacity;
+  }
+
+private:
+  using TimePoint = std::chrono::steady_clock::time_point;
+  static constexpr TimePoint NO_TIMEOUT = TimePoint::max();
+
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* value() {
+      return std::launder(reinterpret_cast<T*>(storage));
+    }
+  };
+
+  const std::size_t capacity;
+  const std::size_t mask;
+  Slot* const slots;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position{0};
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_position{0};
+  // bumped by an enqueue (dequeue) that finds sleepers, so that they notice the change
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> not_empty{0};
+  std::atomic<std::uint32_t> empty_waiters{0};
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> not_full{0};
+  std::atomic<std::uint32_t> full_waiters{0};
+
+  static std::size_t round_up_to_power_of_two(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+      result *= 2;
+    }
+
+    return result;
+  }
+
+  // The new state is published before the waiters check, and a waiter registers before it
+  // reads the word and checks again, so either the waiter sees the change or we see the waiter.
+  // Without sleepers the word is only read, so its cache line is not bounced on every operation.
+  static void notify(std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waiters) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load()) {
+      word.fetch_add(1);
+      futex_wake(word, false);
+    }
+  }
+
+  // spins on ready, then sleeps on word until ready or the deadline
+  template <typename Ready>
+  static bool wait_until(Ready ready, std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waiters, TimePoint deadline) {
+    for (unsigned i = 0; i < MPMC_SPIN_LIMIT; ++i) {
+      if (ready()) {
+        return true;
+      }
+      cpu_relax();
+    }
+
+    while (true) {
+      waiters.fetch_add(1);
+      // pairs with the fence in notify
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::uint32_t seen = word.load();
+
+      if (ready()) {
+        waiters.fetch_sub(1);
+        return true;
+      }
+
+      std::chrono::nanoseconds timeout(-1);
+      if (deadline != NO_TIMEOUT) {
+        timeout = deadline - std::chrono::steady_clock::now();
+        if (timeout.count() <= 0) {
+          waiters.fetch_sub(1);
+          return ready();
+        }
+      }
+
+      futex_wait(word, seen, timeout);
+      waiters.fetch_sub(1);
+    }
+  }
+
+  // takes the next element if there is one and hands it to consume
+  template <typename Consume>
+  bool try_consume(Consume consume) {
+    std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+
+    while (true) {
+      Slot& slot = slots[position & mask];
+      std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      std::ptrdiff_t difference = std::ptrdiff_t(sequence - (position + 1));
+
+      if (difference == 0) {
+        if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          consume(std::move(*slot.value()));
+          slot.value()->~T();
+          slot.sequence.store(position + capacity, std::memory_order_release);
+          notify(not_full, full_waiters);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = dequeue_position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template <typename U>
+  bool enqueue_until(U&& element, TimePoint deadline) {
+    return wait_until([this, &element]() {
+      return try_emplace(std::forward<U>(element));
+    }, not_full, full_waiters, deadline);
+  }
+
+  bool dequeue_until(T& result, TimePoint deadline) {
+    return wait_until([this, &result]() {
+      return try_dequeue(result);
+    }, not_empty, empty_waiters, deadline);
+  }
+};
+
+#endif
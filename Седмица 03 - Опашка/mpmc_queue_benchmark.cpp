@@ -0,0 +1,110 @@
+#include "benchmark.hpp"
+#include "mpmc_queue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+constexpr std::size_t QUEUE_CAPACITY = 1024;
+// every consumer keeps the latency of every SAMPLE_EVERY-th message it takes
+constexpr std::size_t SAMPLE_EVERY = 16;
+// what a consumer takes as the end of the stream
+constexpr std::uint64_t STOP = 0;
+
+std::uint64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count() + 1;
+}
+
+struct Result {
+  double time;
+  // enqueue to dequeue, in microseconds
+  double p50, p99;
+};
+
+// the producers send their enqueue time, the consumers record how long it waited in the queue
+Result run(std::size_t producers, std::size_t consumers, std::size_t messages) {
+  MpmcQueue<std::uint64_t> queue(QUEUE_CAPACITY);
+  std::vector<std::vector<std::uint64_t>> latencies(consumers);
+
+  double time = measure([&]() {
+    std::vector<std::thread> threads;
+
+    for (std::size_t c = 0; c < consumers; ++c) {
+      threads.emplace_back([&queue, &latencies, c]() {
+        std::uint64_t sent;
+        for (std::size_t taken = 0;; ++taken) {
+          queue.dequeue(sent);
+          if (sent == STOP) {
+            return;
+          }
+
+          if (taken % SAMPLE_EVERY == 0) {
+            latencies[c].push_back(now() - sent);
+          }
+        }
+      });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+      producer_threads.emplace_back([&queue, producers, messages]() {
+        for (std::size_t i = 0; i < messages / producers; ++i) {
+          queue.enqueue(now());
+        }
+      });
+    }
+
+    for (std::thread& producer : producer_threads) {
+      producer.join();
+    }
+    for (std::size_t c = 0; c < consumers; ++c) {
+      queue.enqueue(STOP);
+    }
+    for (std::thread& consumer : threads) {
+      consumer.join();
+    }
+  });
+
+  std::vector<std::uint64_t> all;
+  for (const std::vector<std::uint64_t>& samples : latencies) {
+    all.insert(all.end(), samples.begin(), samples.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  auto percentile = [&all](double p) {
+    return all.empty() ? 0.0 : all[std::size_t(p * (all.size() - 1))] / 1000.0;
+  };
+
+  return {time, percentile(0.5), percentile(0.99)};
+}
+
+// usage: mpmc_queue_benchmark [messages]
+int main(int argc, char* argv[]) {
+  std::size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+  const std::size_t counts[] = {1, 2, 4, 8, 16};
+
+  std::cout << messages << " messages, capacity " << QUEUE_CAPACITY << ", "
+            << std::thread::hardware_concurrency() << " hardware threads\n"
+            << std::setw(10) << "producers" << std::setw(10) << "consumers"
+            << std::setw(12) << "M msg/s" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << '\n';
+
+  for (std::size_t producers : counts) {
+    for (std::size_t consumers : counts) {
+      Result result = run(producers, consumers, messages);
+
+      std::cout << std::setw(10) << producers << std::setw(10) << consumers
+                << std::setw(12) << std::fixed << std::setprecision(2) << messages / result.time / 1000.0
+                << std::setw(12) << result.p50
+                << std::setw(12) << result.p99 << '\n';
+    }
+  }
+
+  return 0;
+}
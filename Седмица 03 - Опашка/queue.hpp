@@ -5,6 +5,7 @@ template <typename T>
 class Queue {
 public:
   virtual void enqueue(const T&) = 0;
+  virtual void enqueue(T&&) = 0;
   virtual void dequeue() = 0;
   virtual T& first() = 0; 
   virtual const T& first() const = 0;
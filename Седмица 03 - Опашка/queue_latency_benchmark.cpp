@@ -0,0 +1,73 @@
+#include "queue_with_stacks.hpp"
+#include "real_time_queue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+constexpr double SLOW_OPERATION = 100000;
+
+// keeps the queue depth elements deep and times every enqueue and dequeue on the way
+template <typename Q>
+std::vector<double> operation_times(std::size_t depth, std::size_t operations) {
+  Q queue;
+  std::vector<double> times;
+  times.reserve(operations);
+  // long enough not to fit in the small string buffer, so a copy allocates
+  const std::string message(40, 'x');
+
+  for (std::size_t i = 0; i < depth; ++i) {
+    queue.enqueue(message);
+  }
+
+  for (std::size_t i = 0; i < operations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    if (i % 2 == 0) {
+      queue.enqueue(message);
+    } else {
+      queue.dequeue();
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    times.push_back(std::chrono::duration<double, std::nano>(finish - start).count());
+  }
+
+  return times;
+}
+
+template <typename Q>
+void report(const std::string& name, std::size_t depth, std::size_t operations) {
+  std::vector<double> times = operation_times<Q>(depth, operations);
+  std::sort(times.begin(), times.end());
+
+  auto percentile = [&times](double p) {
+    return times[std::size_t(p * (times.size() - 1))];
+  };
+
+  std::cout << std::setw(18) << name << std::fixed << std::setprecision(0)
+            << std::setw(10) << percentile(0.5)
+            << std::setw(10) << percentile(0.99)
+            << std::setw(10) << percentile(0.999)
+            << std::setw(14) << times.back()
+            // the slow transfers, as opposed to the odd preemption by the OS
+            << std::setw(12) << times.end() - std::upper_bound(times.begin(), times.end(), SLOW_OPERATION) << '\n';
+}
+
+// usage: queue_latency_benchmark [depth] [operations]
+int main(int argc, char* argv[]) {
+  std::size_t depth = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+
+  std::cout << operations << " alternating enqueue/dequeue at depth " << depth << ", ns per operation\n"
+            << std::setw(18) << "queue"
+            << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(14) << "max" << std::setw(12) << "over 100us" << '\n';
+
+  report<QueueWithStacks<std::string>>("QueueWithStacks", depth, operations);
+  report<RealTimeQueue<std::string>>("RealTimeQueue", depth, operations);
+
+  return 0;
+}
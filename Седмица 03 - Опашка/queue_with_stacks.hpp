@@ -3,6 +3,7 @@
 
 #include "queue.hpp"
 #include <stack>
+#include <utility>
 
 template <typename T>
 class QueueWithStacks : public Queue<T> {
@@ -15,6 +16,14 @@ public:
     }
   }
 
+  void enqueue(T&& element) {
+    if (empty()) {
+      bottom.push(std::move(element));
+    } else {
+      top.push(std::move(element));
+    }
+  }
+
   void dequeue() {
     bottom.pop();
     if (bottom.empty()) {
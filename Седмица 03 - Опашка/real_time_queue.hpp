@@ -0,0 +1,93 @@
+#ifndef REAL_TIME_QUEUE_HPP
+#define REAL_TIME_QUEUE_HPP
+
+#include "queue.hpp"
+#include <cstddef>
+#include <deque>
+#include <stack>
+#include <utility>
+
+// how many elements every operation moves from the reversed rear towards the front
+constexpr std::size_t ROTATION_STEPS = 2;
+
+// Queue with stacks where no operation reverses a whole stack at once (Hood, Melville).
+// As soon as the rear stack grows larger than the front, it is frozen and reversed
+// a couple of elements per operation while new elements go to a fresh rear. The
+// reversed stack is then queued behind the current front as another front segment.
+// A rotation of r <= f + 1 elements ends within (r + 1) / 2 operations, before f
+// dequeues can empty the front, so every operation does O(1) work in the worst case.
+// Each segment is larger than everything before it, so there are O(log n) of them.
+template <typename T>
+class RealTimeQueue : public Queue<T> {
+public:
+  RealTimeQueue() : front_size(0), rotating(false) {}
+
+  void enqueue(const T& element) {
+    rear.push(element);
+    rotate();
+  }
+
+  void enqueue(T&& element) {
+    rear.push(std::move(element));
+    rotate();
+  }
+
+  void dequeue() {
+    front.front().pop();
+    if (front.front().empty()) {
+      front.pop_front();
+    }
+
+    --front_size;
+    rotate();
+  }
+
+  T& first() {
+    return front.front().top();
+  }
+
+  const T& first() const {
+    return front.front().top();
+  }
+
+  bool empty() const {
+    return front_size == 0 && !rotating && rear.empty();
+  }
+
+  std::size_t get_size() const {
+    return front_size + frozen.size() + reversed.size() + rear.size();
+  }
+
+private:
+  // the segments in queue order, the top of each is its first element
+  std::deque<std::stack<T>> front;
+  std::size_t front_size;
+  // the old rear being reversed into reversed
+  std::stack<T> frozen, reversed;
+  bool rotating;
+  std::stack<T> rear;
+
+  void rotate() {
+    if (!rotating && rear.size() > front_size) {
+      std::swap(frozen, rear);
+      rotating = true;
+    }
+
+    if (!rotating) {
+      return;
+    }
+
+    for (std::size_t i = 0; i < ROTATION_STEPS && !frozen.empty(); ++i) {
+      reversed.push(std::move(frozen.top()));
+      frozen.pop();
+    }
+
+    if (frozen.empty()) {
+      front_size += reversed.size();
+      front.push_back(std::exchange(reversed, std::stack<T>()));
+      rotating = false;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef RING_DEQUE_HPP
+#define RING_DEQUE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Double-ended queue in a circular array - a static queue that doubles its
+// array when it fills up. The capacity is a power of two, so wrapping an index
+// around is a mask instead of a division.
+template <typename T>
+class RingDeque {
+public:
+  explicit RingDeque(std::size_t capacity = 16) : head(0), size(0) {
+    std::size_t length = 1;
+    while (length < capacity) {
+      length *= 2;
+    }
+    items.resize(length);
+  }
+
+  void push_back(const T& element) {
+    if (size == items.size()) {
+      grow();
+    }
+    items[(head + size) & (items.size() - 1)] = element;
+    ++size;
+  }
+
+  void push_front(const T& element) {
+    if (size == items.size()) {
+      grow();
+    }
+    head = (head - 1) & (items.size() - 1);
+    items[head] = element;
+    ++size;
+  }
+
+  void pop_front() {
+    head = (head + 1) & (items.size() - 1);
+    --size;
+  }
+
+  void pop_back() {
+    --size;
+  }
+
+  const T& front() const {
+    return items[head];
+  }
+
+  const T& back() const {
+    return items[(head + size - 1) & (items.size() - 1)];
+  }
+
+  // the i-th element from the front
+  const T& operator[](std::size_t i) const {
+    return items[(head + i) & (items.size() - 1)];
+  }
+
+  bool empty() const {
+    return size == 0;
+  }
+
+  std::size_t get_size() const {
+    return size;
+  }
+
+  void clear() {
+    head = size = 0;
+  }
+
+private:
+  std::vector<T> items;
+  std::size_t head, size;
+
+  void grow() {
+    std::vector<T> bigger(2 * items.size());
+    for (std::size_t i = 0; i < size; ++i) {
+      bigger[i] = std::move(items[(head + i) & (items.size() - 1)]);
+    }
+
+    items = std::move(bigger);
+    head = 0;
+  }
+};
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef SLIDING_WINDOW_HPP
+#define SLIDING_WINDOW_HPP
+
+#include "ring_deque.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// An aggregate sees every element twice - push when it enters the window and pop
+// when it leaves - and both get the position of the element in the stream:
+//   void reserve(std::size_t window);
+//   void push(std::size_t index, const T& value);
+//   void pop(std::size_t index, const T& value);
+//   result() const;
+// Elements leave in the order they entered.
+
+// the first negative element in the window, or 0 when there is none
+template <typename T>
+class FirstNegative {
+public:
+  void reserve(std::size_t) {}
+
+  void push(std::size_t index, const T& value) {
+    if (value < T()) {
+      negatives.push_back({index, value});
+    }
+  }
+
+  void pop(std::size_t index, const T&) {
+    if (!negatives.empty() && negatives.front().first == index) {
+      negatives.pop_front();
+    }
+  }
+
+  T result() const {
+    return negatives.empty() ? T() : negatives.front().second;
+  }
+
+private:
+  RingDeque<std::pair<std::size_t, T>> negatives;
+};
+
+// Monotonic deque: only the elements that are smaller than everything after them
+// can become the minimum, so those are the only ones kept and they are increasing.
+// Every element is pushed and popped at most once - O(1) amortized.
+template <typename T, typename Compare = std::less<T>>
+class WindowMinimum {
+public:
+  explicit WindowMinimum(Compare compare = Compare()) : compare(compare) {}
+
+  void reserve(std::size_t window) {
+    candidates = RingDeque<std::pair<std::size_t, T>>(window);
+  }
+
+  void push(std::size_t index, const T& value) {
+    while (!candidates.empty() && !compare(candidates.back().second, value)) {
+      candidates.pop_back();
+    }
+    candidates.push_back({index, value});
+  }
+
+  void pop(std::size_t index, const T&) {
+    if (candidates.front().first == index) {
+      candidates.pop_front();
+    }
+  }
+
+  const T& result() const {
+    return candidates.front().second;
+  }
+
+private:
+  RingDeque<std::pair<std::size_t, T>> candidates;
+  Compare compare;
+};
+
+template <typename T>
+using WindowMaximum = WindowMinimum<T, std::greater<T>>;
+
+// floating point sums drift over a long stream, the fixed window functions below do not
+template <typename T>
+class WindowSum {
+public:
+  WindowSum() : sum() {}
+
+  void reserve(std::size_t) {}
+
+  void push(std::size_t, const T& value) {
+    sum += value;
+  }
+
+  void pop(std::size_t, const T& value) {
+    sum -= value;
+  }
+
+  const T& result() const {
+    return sum;
+  }
+
+private:
+  T sum;
+};
+
+template <typename T, typename Predicate>
+class WindowCount {
+public:
+  explicit WindowCount(Predicate predicate = Predicate()) : predicate(predicate), count(0) {}
+
+  void reserve(std::size_t) {}
+
+  void push(std::size_t, const T& value) {
+    count += bool(predicate(value));
+  }
+
+  void pop(std::size_t, const T& value) {
+    count -= bool(predicate(value));
+  }
+
+  std::size_t result() const {
+    return count;
+  }
+
+private:
+  Predicate predicate;
+  std::size_t count;
+};
+
+// Streaming window over the last `window` elements. It remembers the window in a
+// circular array, so the elements leaving it can be handed to the aggregate.
+template <typename T, typename Aggregate>
+class SlidingWindow {
+public:
+  explicit SlidingWindow(std::size_t window, Aggregate aggregate = Aggregate())
+    : aggregate(std::move(aggregate)), values(window), next(0), count(0) {
+    if (window == 0) {
+      throw std::invalid_argument("SlidingWindow: the window must not be empty");
+    }
+    this->aggregate.reserve(window);
+  }
+
+  void push(const T& value) {
+    if (count >= values.size()) {
+      aggregate.pop(count - values.size(), values[next]);
+    }
+
+    aggregate.push(count, value);
+    values[next] = value;
+    next = next + 1 == values.size() ? 0 : next + 1;
+    ++count;
+  }
+
+  // pushes a batch and writes the result after every element that completes a window
+  template <typename OutputIterator>
+  OutputIterator push(const T* begin, const T* end, OutputIterator out) {
+    // until the element that fills the window there is nothing to write
+    for (; begin != end && count + 1 < values.size(); ++begin) {
+      push(*begin);
+    }
+
+    for (; begin != end; ++begin) {
+      push(*begin);
+      *out++ = result();
+    }
+
+    return out;
+  }
+
+  // the window holds `window` elements - before that result() covers only the ones seen
+  bool full() const {
+    return count >= values.size();
+  }
+
+  decltype(auto) result() const {
+    return aggregate.result();
+  }
+
+  std::size_t get_window() const {
+    return values.size();
+  }
+
+  // elements pushed since the start of the stream
+  std::size_t get_count() const {
+    return count;
+  }
+
+private:
+  Aggregate aggregate;
+  std::vector<T> values;
+  std::size_t next, count;
+};
+
+enum class WindowOperation {
+  SUM,
+  MIN,
+  MAX
+};
+
+template <WindowOperation Operation, typename T>
+T apply_window_operation(const T& left, const T& right) {
+  if constexpr (Operation == WindowOperation::SUM) {
+    return left + right;
+  } else if constexpr (Operation == WindowOperation::MIN) {
+    return std::min(left, right);
+  } else {
+    return std::max(left, right);
+  }
+}
+
+// left = left op right for count values, four doubles at a time with AVX
+template <WindowOperation Operation, typename T>
+void apply_window_batch(T* left, const T* right, std::size_t count) {
+  std::size_t i = 0;
+
+#ifdef __AVX2__
+  if constexpr (std::is_same_v<T, double>) {
+    for (; i + 4 <= count; i += 4) {
+      __m256d a = _mm256_loadu_pd(left + i);
+      __m256d b = _mm256_loadu_pd(right + i);
+
+      if constexpr (Operation == WindowOperation::SUM) {
+        a = _mm256_add_pd(a, b);
+      } else if constexpr (Operation == WindowOperation::MIN) {
+        a = _mm256_min_pd(a, b);
+      } else {
+        a = _mm256_max_pd(a, b);
+      }
+
+      _mm256_storeu_pd(left + i, a);
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    left[i] = apply_window_operation<Operation>(left[i], right[i]);
+  }
+}
+
+// Sum, minimum or maximum of every window of a fixed size in an array (van Herk,
+// Gil-Werman). The array is cut into blocks of `window` elements, so every window
+// is a suffix of one block followed by a prefix of the next. With both running
+// totals at hand every result is a single operation over two arrays - no branches
+// and no dependency between neighbouring results, so they are computed four at a
+// time. Writes size - window + 1 results.
+template <WindowOperation Operation, typename T>
+void sliding_window(const T* data, std::size_t size, std::size_t window, T* result) {
+  if (window == 0) {
+    throw std::invalid_argument("sliding_window: the window must not be empty");
+  }
+  if (size < window) {
+    return;
+  }
+
+  std::size_t results = size - window + 1;
+  std::vector<T> prefix(window);
+
+  for (std::size_t block = 0; block < results; block += window) {
+    // the windows starting in this block
+    std::size_t count = std::min(window, results - block);
+    const T* values = data + block;
+
+    // suffixes of the block, from its end - only the first count start a window here
+    T suffix = values[window - 1];
+    for (std::size_t k = window - 1; k-- > count;) {
+      suffix = apply_window_operation<Operation>(values[k], suffix);
+    }
+    if (count == window) {
+      result[block + window - 1] = suffix;
+    }
+    for (std::size_t k = std::min(count, window - 1); k-- > 0;) {
+      suffix = apply_window_operation<Operation>(values[k], suffix);
+      result[block + k] = suffix;
+    }
+
+    // prefixes of the next block, then window k ends at prefix k - 1
+    if (count > 1) {
+      const T* following = values + window;
+      prefix[0] = following[0];
+      for (std::size_t k = 1; k + 1 < count; ++k) {
+        prefix[k] = apply_window_operation<Operation>(prefix[k - 1], following[k]);
+      }
+      apply_window_batch<Operation>(result + block + 1, prefix.data(), count - 1);
+    }
+  }
+}
+
+template <typename T>
+void sliding_sum(const T* data, std::size_t size, std::size_t window, T* result) {
+  sliding_window<WindowOperation::SUM>(data, size, window, result);
+}
+
+template <typename T>
+void sliding_min(const T* data, std::size_t size, std::size_t window, T* result) {
+  sliding_window<WindowOperation::MIN>(data, size, window, result);
+}
+
+template <typename T>
+void sliding_max(const T* data, std::size_t size, std::size_t window, T* result) {
+  sliding_window<WindowOperation::MAX>(data, size, window, result);
+}
+
+#endif
@@ -0,0 +1,159 @@
+#include "benchmark.hpp"
+#include "sliding_window.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+// the original week 03 approach: a queue of indices of the window, with the front moved to the first negative
+std::vector<double> first_negative_with_queue(const std::vector<double>& data, std::size_t window) {
+  std::vector<double> result;
+  std::queue<std::size_t> indices;
+
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    indices.push(i);
+    if (i - indices.front() == window) {
+      indices.pop();
+    }
+
+    while (!indices.empty() && data[indices.front()] >= 0) {
+      indices.pop();
+    }
+
+    if (i + 1 >= window) {
+      result.push_back(indices.empty() ? 0 : data[indices.front()]);
+    }
+  }
+
+  return result;
+}
+
+// every window recomputed from scratch - O(n * window)
+template <WindowOperation Operation>
+std::vector<double> naive(const std::vector<double>& data, std::size_t window) {
+  std::vector<double> result(data.size() - window + 1);
+
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    double total = data[i];
+    for (std::size_t j = i + 1; j < i + window; ++j) {
+      total = apply_window_operation<Operation>(total, data[j]);
+    }
+    result[i] = total;
+  }
+
+  return result;
+}
+
+// one element at a time, as values arrive from a stream
+template <typename Aggregate>
+std::vector<double> streaming(const std::vector<double>& data, std::size_t window) {
+  std::vector<double> result;
+  result.reserve(data.size());
+  SlidingWindow<double, Aggregate> engine(window);
+
+  for (double value : data) {
+    engine.push(value);
+    if (engine.full()) {
+      result.push_back(engine.result());
+    }
+  }
+
+  return result;
+}
+
+template <typename Aggregate>
+std::vector<double> batched(const std::vector<double>& data, std::size_t window, std::size_t batch) {
+  std::vector<double> result;
+  result.reserve(data.size());
+  SlidingWindow<double, Aggregate> engine(window);
+
+  for (std::size_t i = 0; i < data.size(); i += batch) {
+    std::size_t end = std::min(data.size(), i + batch);
+    engine.push(data.data() + i, data.data() + end, std::back_inserter(result));
+  }
+
+  return result;
+}
+
+template <WindowOperation Operation>
+std::vector<double> fixed(const std::vector<double>& data, std::size_t window) {
+  std::vector<double> result(data.size() - window + 1);
+  sliding_window<Operation>(data.data(), data.size(), window, result.data());
+  return result;
+}
+
+template <typename Function>
+void report(const std::string& name, std::size_t elements, const std::vector<double>& expected, Function function) {
+  std::vector<double> result;
+  double time = measure([&]() {
+    result = function();
+  });
+
+  bool correct = result.size() == expected.size();
+  for (std::size_t i = 0; correct && i < result.size(); ++i) {
+    // the sums are added up in a different order
+    correct = std::abs(result[i] - expected[i]) <= 1e-6 * (1 + std::abs(expected[i]));
+  }
+
+  std::cout << std::setw(28) << name << std::fixed << std::setprecision(1)
+            << std::setw(12) << time << "ms"
+            << std::setw(12) << elements / time / 1000 << " M/s"
+            << (correct ? "" : "  WRONG") << '\n';
+}
+
+// usage: sliding_window_benchmark [elements] [batch]
+int main(int argc, char* argv[]) {
+  std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::size_t batch = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+
+  // a random walk, like a metric that moves a little between samples
+  std::mt19937 random(42);
+  std::normal_distribution<double> change(0, 1);
+  std::vector<double> data(elements);
+  double value = 0;
+  for (double& element : data) {
+    value += change(random);
+    element = value;
+  }
+
+  for (std::size_t window : {16, 1024, 65536}) {
+    std::cout << "\nwindow " << window << ", " << elements << " elements, batches of " << batch << '\n';
+    std::vector<double> expected;
+
+    std::cout << "first negative\n";
+    expected = first_negative_with_queue(data, window);
+    report("std::queue of indices", elements, expected, [&]() { return first_negative_with_queue(data, window); });
+    report("streaming", elements, expected, [&]() { return streaming<FirstNegative<double>>(data, window); });
+    report("batched", elements, expected, [&]() { return batched<FirstNegative<double>>(data, window, batch); });
+
+    std::cout << "min\n";
+    expected = fixed<WindowOperation::MIN>(data, window);
+    if (window <= 16) {
+      report("naive", elements, expected, [&]() { return naive<WindowOperation::MIN>(data, window); });
+    }
+    report("streaming", elements, expected, [&]() { return streaming<WindowMinimum<double>>(data, window); });
+    report("batched", elements, expected, [&]() { return batched<WindowMinimum<double>>(data, window, batch); });
+    report("fixed window", elements, expected, [&]() { return fixed<WindowOperation::MIN>(data, window); });
+
+    std::cout << "max\n";
+    expected = fixed<WindowOperation::MAX>(data, window);
+    report("streaming", elements, expected, [&]() { return streaming<WindowMaximum<double>>(data, window); });
+    report("batched", elements, expected, [&]() { return batched<WindowMaximum<double>>(data, window, batch); });
+    report("fixed window", elements, expected, [&]() { return fixed<WindowOperation::MAX>(data, window); });
+
+    std::cout << "sum\n";
+    expected = fixed<WindowOperation::SUM>(data, window);
+    report("streaming", elements, expected, [&]() { return streaming<WindowSum<double>>(data, window); });
+    report("batched", elements, expected, [&]() { return batched<WindowSum<double>>(data, window, batch); });
+    report("fixed window", elements, expected, [&]() { return fixed<WindowOperation::SUM>(data, window); });
+  }
+
+  return 0;
+}
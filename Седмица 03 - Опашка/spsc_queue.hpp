@@ -0,0 +1,181 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include "concurrency.hpp"
+#include "queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+// Fixed capacity ring buffer for exactly one producer thread and one consumer thread.
+// Only the producer writes tail and only the consumer writes head, each on its own
+// cache line. Each side keeps a cached copy of the other's index and reloads it
+// only when the ring looks full (or empty), so most operations touch no shared line
+// except for the slot itself.
+template <typename T>
+class SpscQueue : public Queue<T> {
+public:
+  // the capacity is rounded up to a power of two so that a position is index & mask
+  explicit SpscQueue(std::size_t capacity)
+    : capacity(round_up_to_power_of_two(std::max<std::size_t>(capacity, 2))),
+      mask(this->capacity - 1),
+      data(std::allocator<T>().allocate(this->capacity)) {}
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+  ~SpscQueue() {
+    std::size_t head = consumer.index.load(std::memory_order_relaxed);
+    std::size_t tail = producer.index.load(std::memory_order_relaxed);
+
+    for (; head != tail; ++head) {
+      data[head & mask].~T();
+    }
+    std::allocator<T>().deallocate(data, capacity);
+  }
+
+  // producer: waits while the queue is full
+  void enqueue(const T& element) {
+    while (!try_emplace(element)) {
+      std::this_thread::yield();
+    }
+  }
+
+  void enqueue(T&& element) {
+    while (!try_emplace(std::move(element))) {
+      std::this_thread::yield();
+    }
+  }
+
+  bool try_enqueue(const T& element) {
+    return try_emplace(element);
+  }
+
+  bool try_enqueue(T&& element) {
+    return try_emplace(std::move(element));
+  }
+
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    std::size_t tail = producer.index.load(std::memory_order_relaxed);
+
+    if (tail - producer.cached_other == capacity) {
+      producer.cached_other = consumer.index.load(std::memory_order_acquire);
+      if (tail - producer.cached_other == capacity) {
+        return false;
+      }
+    }
+
+    new (data + (tail & mask)) T(std::forward<Args>(args)...);
+    producer.index.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // producer: copies as many of [begin, begin + count) as fit with a single publish, returns how many
+  std::size_t enqueue_bulk(const T* begin, std::size_t count) {
+    std::size_t tail = producer.index.load(std::memory_order_relaxed);
+
+    if (capacity - (tail - producer.cached_other) < count) {
+      producer.cached_other = consumer.index.load(std::memory_order_acquire);
+    }
+    count = std::min(count, capacity - (tail - producer.cached_other));
+
+    // the free space may wrap around the end of the buffer
+    std::size_t position = tail & mask;
+    std::size_t first_part = std::min(count, capacity - position);
+    std::uninitialized_copy(begin, begin + first_part, data + position);
+    std::uninitialized_copy(begin + first_part, begin + count, data);
+
+    producer.index.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // consumer: expects a non-empty queue, like the other queues
+  void dequeue() {
+    std::size_t head = consumer.index.load(std::memory_order_relaxed);
+    data[head & mask].~T();
+    consumer.index.store(head + 1, std::memory_order_release);
+  }
+
+  bool try_dequeue(T& result) {
+    if (empty()) {
+      return false;
+    }
+
+    std::size_t head = consumer.index.load(std::memory_order_relaxed);
+    result = std::move(data[head & mask]);
+    data[head & mask].~T();
+    consumer.index.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer: moves up to count elements into result with a single publish, returns how many
+  std::size_t dequeue_bulk(T* result, std::size_t count) {
+    std::size_t head = consumer.index.load(std::memory_order_relaxed);
+
+    if (consumer.cached_other - head < count) {
+      consumer.cached_other = producer.index.load(std::memory_order_acquire);
+    }
+    count = std::min(count, consumer.cached_other - head);
+
+    std::size_t position = head & mask;
+    std::size_t first_part = std::min(count, capacity - position);
+    std::move(data + position, data + position + first_part, result);
+    std::move(data, data + count - first_part, result + first_part);
+    std::destroy(data + position, data + position + first_part);
+    std::destroy(data, data + count - first_part);
+
+    consumer.index.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  // consumer
+  T& first() {
+    return data[consumer.index.load(std::memory_order_relaxed) & mask];
+  }
+
+  const T& first() const {
+    return data[consumer.index.load(std::memory_order_relaxed) & mask];
+  }
+
+  // consumer: the producer may fill the queue right after, but never empty it
+  bool empty() const {
+    std::size_t head = consumer.index.load(std::memory_order_relaxed);
+    if (consumer.cached_other != head) {
+      return false;
+    }
+
+    consumer.cached_other = producer.index.load(std::memory_order_acquire);
+    return consumer.cached_other == head;
+  }
+
+  std::size_t get_capacity() const {
+    return capacity;
+  }
+
+private:
+  // the index a side writes and its last look at the other side's index
+  struct alignas(CACHE_LINE_SIZE) Side {
+    std::atomic<std::size_t> index{0};
+    mutable std::size_t cached_other = 0;
+  };
+
+  const std::size_t capacity;
+  const std::size_t mask;
+  T* const data;
+  Side producer;
+  Side consumer;
+
+  static std::size_t round_up_to_power_of_two(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+      result *= 2;
+    }
+
+    return result;
+  }
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "benchmark.hpp"
+#include "spsc_queue.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr std::size_t QUEUE_CAPACITY = 1 << 14;
+constexpr std::size_t BULK_SIZE = 64;
+
+// what the pipeline threads would use without a dedicated queue
+class MutexQueue {
+public:
+  explicit MutexQueue(std::size_t capacity) : capacity(capacity) {}
+
+  bool try_enqueue(unsigned element) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.size() == capacity) {
+      return false;
+    }
+
+    queue.push(element);
+    return true;
+  }
+
+  bool try_dequeue(unsigned& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.empty()) {
+      return false;
+    }
+
+    result = queue.front();
+    queue.pop();
+    return true;
+  }
+
+private:
+  std::size_t capacity;
+  std::mutex mutex;
+  std::queue<unsigned> queue;
+};
+
+// the producer sends 0..messages-1, the consumer adds them up
+template <typename Send, typename Receive>
+double transfer(std::size_t messages, Send send, Receive receive, bool& correct) {
+  unsigned long long sum = 0;
+
+  double time = measure([&]() {
+    std::thread producer([&]() {
+      send(messages);
+    });
+    sum = receive(messages);
+    producer.join();
+  });
+
+  correct = correct && sum == (unsigned long long)messages * (messages - 1) / 2;
+  return time;
+}
+
+template <typename Q>
+double one_by_one(std::size_t messages, bool& correct) {
+  Q queue(QUEUE_CAPACITY);
+
+  return transfer(messages, [&queue](std::size_t count) {
+    for (unsigned i = 0; i < count; ++i) {
+      while (!queue.try_enqueue(i)) {
+        std::this_thread::yield();
+      }
+    }
+  }, [&queue](std::size_t count) {
+    unsigned long long sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      unsigned value;
+      while (!queue.try_dequeue(value)) {
+        std::this_thread::yield();
+      }
+      sum += value;
+    }
+    return sum;
+  }, correct);
+}
+
+double bulk(std::size_t messages, bool& correct) {
+  SpscQueue<unsigned> queue(QUEUE_CAPACITY);
+
+  return transfer(messages, [&queue](std::size_t count) {
+    unsigned batch[BULK_SIZE];
+    for (std::size_t sent = 0; sent < count;) {
+      std::size_t size = std::min(BULK_SIZE, count - sent);
+      for (std::size_t i = 0; i < size; ++i) {
+        batch[i] = unsigned(sent + i);
+      }
+
+      for (std::size_t done = 0; done < size;) {
+        std::size_t pushed = queue.enqueue_bulk(batch + done, size - done);
+        if (!pushed) {
+          std::this_thread::yield();
+        }
+        done += pushed;
+      }
+      sent += size;
+    }
+  }, [&queue](std::size_t count) {
+    unsigned long long sum = 0;
+    unsigned batch[BULK_SIZE];
+    for (std::size_t received = 0; received < count;) {
+      std::size_t size = queue.dequeue_bulk(batch, BULK_SIZE);
+      if (!size) {
+        std::this_thread::yield();
+      }
+
+      for (std::size_t i = 0; i < size; ++i) {
+        sum += batch[i];
+      }
+      received += size;
+    }
+    return sum;
+  }, correct);
+}
+
+// usage: spsc_queue_benchmark [messages]
+int main(int argc, char* argv[]) {
+  std::size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+  bool correct = true;
+
+  std::cout << messages << " messages between two threads, capacity " << QUEUE_CAPACITY << '\n';
+
+  auto report = [messages](const std::string& name, double time) {
+    std::cout << std::setw(28) << name
+              << std::setw(10) << std::fixed << std::setprecision(1) << time << "ms"
+              << std::setw(10) << messages / time / 1000.0 << "M/s\n";
+  };
+
+  report("mutex + std::queue", one_by_one<MutexQueue>(messages, correct));
+  report("SpscQueue", one_by_one<SpscQueue<unsigned>>(messages, correct));
+  report("SpscQueue, bulk of 64", bulk(messages, correct));
+
+  if (!correct) {
+    std::cout << "CHECKSUM MISMATCH\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+#include "../Седмица 01 - Сложност на алгоритми/parallel_sort.hpp"
+#include "../Седмица 01 - Сложност на алгоритми/thread_pool.hpp"
+#include "benchmark.hpp"
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// below this a Fibonacci call is computed sequentially - a task is then about 10us of work
+constexpr unsigned FIBONACCI_CUTOFF = 20;
+
+unsigned long long fibonacci(unsigned n) {
+  return n < 2 ? n : fibonacci(n - 1) + fibonacci(n - 2);
+}
+
+// how many tasks parallel_fibonacci(n) spawns
+std::size_t fibonacci_tasks(unsigned n) {
+  return n <= FIBONACCI_CUTOFF ? 0 : 1 + fibonacci_tasks(n - 1) + fibonacci_tasks(n - 2);
+}
+
+// fork fib(n - 1), compute fib(n - 2) on this thread, join
+template <typename Pool>
+unsigned long long parallel_fibonacci(unsigned n, Pool& pool) {
+  if (n <= FIBONACCI_CUTOFF) {
+    return fibonacci(n);
+  }
+
+  unsigned long long first;
+  TaskGroup group;
+  pool.spawn(group, [&first, n, &pool]() {
+    first = parallel_fibonacci(n - 1, pool);
+  });
+
+  unsigned long long second = parallel_fibonacci(n - 2, pool);
+  pool.wait(group);
+  return first + second;
+}
+
+struct Measurement {
+  double time;
+  std::size_t steals;
+  bool correct;
+};
+
+void print(const std::string& pool, unsigned threads, const Measurement& m, double sequential, std::size_t tasks) {
+  std::cout << std::setw(18) << pool << std::setw(8) << threads
+            << std::setw(12) << std::fixed << std::setprecision(1) << m.time << "ms"
+            << std::setw(9) << std::setprecision(2) << sequential / m.time << 'x'
+            << std::setw(10) << m.steals
+            << std::setw(11) << std::setprecision(1) << 100.0 * m.steals / tasks << '%'
+            << (m.correct ? "" : "  WRONG") << '\n';
+}
+
+void print_header(const std::string& title) {
+  std::cout << '\n' << title << '\n'
+            << std::setw(18) << "pool" << std::setw(8) << "threads" << std::setw(14) << "time"
+            << std::setw(10) << "speedup" << std::setw(10) << "steals" << std::setw(12) << "steal rate" << '\n';
+}
+
+// ThreadPool(n) starts n - 1 workers and WorkStealingPool(n) starts n, while in both the
+// waiting thread runs tasks too - the constructor arguments give both the same running threads
+template <typename Pool>
+unsigned pool_argument(unsigned threads);
+
+template <>
+unsigned pool_argument<ThreadPool>(unsigned threads) {
+  return threads;
+}
+
+template <>
+unsigned pool_argument<WorkStealingPool>(unsigned threads) {
+  return threads - 1;
+}
+
+template <typename Pool>
+Measurement fibonacci_run(unsigned n, unsigned threads, unsigned long long expected) {
+  Pool pool(pool_argument<Pool>(threads));
+  unsigned long long result = 0;
+  double time = measure([&]() { result = parallel_fibonacci(n, pool); });
+  return {time, pool.steal_count(), result == expected};
+}
+
+template <typename Pool>
+Measurement sort_run(const std::vector<int>& input, unsigned threads) {
+  Pool pool(pool_argument<Pool>(threads));
+  std::vector<int> data = input;
+  double time = measure([&]() { parallel_quick_sort(data.data(), data.data() + data.size(), pool); });
+  return {time, pool.steal_count(), std::is_sorted(data.begin(), data.end())};
+}
+
+// usage: work_stealing_benchmark [fibonacci n] [sort size]
+int main(int argc, char* argv[]) {
+  unsigned n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 36;
+  std::size_t size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000000;
+  // running threads, from 2 - a WorkStealingPool always has a worker besides the waiting thread
+  const unsigned thread_counts[] = {2, 4, 8, 16};
+
+  unsigned long long expected = 0;
+  double sequential = measure([&]() { expected = fibonacci(n); });
+  std::size_t tasks = fibonacci_tasks(n);
+
+  print_header("fibonacci(" + std::to_string(n) + "), " + std::to_string(tasks) + " tasks, sequential " +
+               std::to_string(int(sequential)) + "ms");
+  for (unsigned threads : thread_counts) {
+    print("ThreadPool", threads, fibonacci_run<ThreadPool>(n, threads, expected), sequential, tasks);
+    print("WorkStealingPool", threads, fibonacci_run<WorkStealingPool>(n, threads, expected), sequential, tasks);
+  }
+
+  std::vector<int> input(size);
+  std::mt19937 generator(42);
+  std::generate(input.begin(), input.end(), generator);
+
+  std::vector<int> data = input;
+  sequential = measure([&]() { quick_sort(data.data(), data.data() + data.size()); });
+  // roughly two tasks per cutoff-sized piece
+  tasks = std::max<std::size_t>(1, 2 * size / PARALLEL_SORT_CUTOFF);
+
+  print_header("parallel_quick_sort, " + std::to_string(size) + " ints, sequential " +
+               std::to_string(int(sequential)) + "ms, steal rate against ~" + std::to_string(tasks) + " tasks");
+  for (unsigned threads : thread_counts) {
+    print("ThreadPool", threads, sort_run<ThreadPool>(input, threads), sequential, tasks);
+    print("WorkStealingPool", threads, sort_run<WorkStealingPool>(input, threads), sequential, tasks);
+  }
+
+  // queue-style submission from outside the pool
+  std::size_t submitted = 1000000;
+  WorkStealingPool pool;
+  std::atomic<std::size_t> done(0);
+  double time = measure([&]() {
+    for (std::size_t i = 0; i < submitted; ++i) {
+      pool.enqueue([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.wait_idle();
+  });
+  std::cout << '\n' << submitted << " tasks enqueued from outside: " << std::setprecision(1) << time << "ms, "
+            << submitted / time / 1000.0 << "M tasks/s" << (done == submitted ? "" : "  LOST TASKS") << '\n';
+
+  return 0;
+}
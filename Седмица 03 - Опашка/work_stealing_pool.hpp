@@ -0,0 +1,235 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include "../Седмица 01 - Сложност на алгоритми/thread_pool.hpp"
+#include "chase_lev_deque.hpp"
+#include "concurrency.hpp"
+#include "mpmc_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// tasks submitted from outside the pool wait here, enqueue blocks when it is full
+constexpr std::size_t INJECTION_CAPACITY = 1 << 12;
+// failed rounds over all the queues before an idle worker goes to sleep
+constexpr unsigned IDLE_ROUNDS = 64;
+// a sleeping worker looks for work at least this often, in case it missed a wake up
+constexpr std::chrono::milliseconds IDLE_TIMEOUT(1);
+
+// Thread pool over Chase-Lev deques, with the same fork-join interface as ThreadPool
+// (spawn/wait on a TaskGroup) and queue-like submission with enqueue.
+// Every worker pushes the tasks it spawns on its own deque and pops them LIFO without
+// locking; idle workers steal the oldest tasks from a random victim. Threads outside
+// the pool submit through a bounded MpmcQueue and, while they wait, run tasks taken
+// from it or stolen from the workers - a deque has only one owner, so they never push.
+class WorkStealingPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency())
+    : injected(INJECTION_CAPACITY), steals(0), stopping(false), work_available(0), sleepers(0) {
+    if (threads == 0) {
+      threads = 1;
+    }
+
+    for (unsigned i = 0; i < threads; ++i) {
+      deques.push_back(std::make_unique<Deque>());
+    }
+
+    for (unsigned i = 0; i < threads; ++i) {
+      workers.emplace_back([this, i]() { work(i); });
+    }
+  }
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+  // Runs every job still in the pool, so no TaskGroup is left waiting for a dropped task.
+  // Jobs spawned while the workers stop are run on this thread after they have joined.
+  ~WorkStealingPool() {
+    wait(detached);
+
+    stopping.store(true);
+    work_available.fetch_add(1);
+    futex_wake(work_available, true);
+
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+
+    // this thread owns deque 0 now, so the leftover jobs push what they spawn there
+    // instead of into the bounded injection queue that only this thread drains
+    const WorkStealingPool* previous_pool = current_pool;
+    std::size_t previous_worker = current_worker;
+    current_pool = this;
+    current_worker = 0;
+
+    Job* job;
+    while (take(0, job)) {
+      run(job);
+    }
+
+    current_pool = previous_pool;
+    current_worker = previous_worker;
+  }
+
+  std::size_t thread_count() const {
+    return deques.size();
+  }
+
+  // runs the task on some worker later - wait_idle waits for everything enqueued
+  void enqueue(Task task) {
+    spawn(detached, std::move(task));
+  }
+
+  void wait_idle() {
+    wait(detached);
+  }
+
+  void spawn(TaskGroup& group, Task task) {
+    group.add();
+    Job* job = new Job{std::move(task), &group};
+
+    std::size_t index = current_index();
+    if (index == NO_WORKER) {
+      injected.enqueue(job);
+    } else {
+      deques[index]->jobs.push(job);
+    }
+
+    notify();
+  }
+
+  // runs pending tasks on the calling thread until all tasks of the group finish
+  void wait(TaskGroup& group) {
+    std::size_t index = current_index();
+
+    while (!group.done()) {
+      Job* job;
+      if (take(index, job)) {
+        run(job);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  std::size_t steal_count() const {
+    return steals.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Job {
+    Task task;
+    TaskGroup* group;
+  };
+
+  struct alignas(CACHE_LINE_SIZE) Deque {
+    ChaseLevDeque<Job*> jobs;
+  };
+
+  static constexpr std::size_t NO_WORKER = std::size_t(-1);
+
+  std::vector<std::unique_ptr<Deque>> deques;
+  std::vector<std::thread> workers;
+  MpmcQueue<Job*> injected;
+  TaskGroup detached;
+  std::atomic<std::size_t> steals;
+  std::atomic<bool> stopping;
+
+  // bumped when there is new work for sleeping workers
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> work_available;
+  std::atomic<std::uint32_t> sleepers;
+
+  static thread_local const WorkStealingPool* current_pool;
+  static thread_local std::size_t current_worker;
+
+  std::size_t current_index() const {
+    return current_pool == this ? current_worker : NO_WORKER;
+  }
+
+  // the new job is published before sleepers is read and a sleeper registers before
+  // it looks for work, so either it finds the job or we see it and wake it up
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load()) {
+      work_available.fetch_add(1);
+      futex_wake(work_available, false);
+    }
+  }
+
+  // own deque first, then the submissions from outside, then a random victim
+  bool take(std::size_t index, Job*& job) {
+    if (index != NO_WORKER && deques[index]->jobs.pop(job)) {
+      return true;
+    }
+
+    if (injected.try_dequeue(job)) {
+      return true;
+    }
+
+    thread_local std::uint32_t seed = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    std::size_t start = seed % deques.size();
+    for (std::size_t i = 0; i < deques.size(); ++i) {
+      std::size_t victim = (start + i) % deques.size();
+      if (victim != index && deques[victim]->jobs.steal(job)) {
+        steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  static void run(Job* job) {
+    job->task();
+    job->group->finish();
+    delete job;
+  }
+
+  void work(std::size_t index) {
+    current_pool = this;
+    current_worker = index;
+
+    unsigned idle = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+      Job* job;
+      if (take(index, job)) {
+        run(job);
+        idle = 0;
+        continue;
+      }
+
+      if (++idle < IDLE_ROUNDS) {
+        cpu_relax();
+        continue;
+      }
+
+      sleepers.fetch_add(1);
+      std::uint32_t seen = work_available.load();
+      if (take(index, job)) {
+        sleepers.fetch_sub(1);
+        run(job);
+      } else if (!stopping.load()) {
+        futex_wait(work_available, seen, IDLE_TIMEOUT);
+        sleepers.fetch_sub(1);
+      } else {
+        sleepers.fetch_sub(1);
+      }
+      idle = 0;
+    }
+  }
+};
+
+inline thread_local const WorkStealingPool* WorkStealingPool::current_pool = nullptr;
+inline thread_local std::size_t WorkStealingPool::current_worker = 0;
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+
+template <typename Function>
+double measure(Function function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef CACHE_COUNTER_HPP
+#define CACHE_COUNTER_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Counts the last level cache misses of the calling thread with the hardware
+// counters of the CPU. Virtual machines and containers often do not expose
+// them (or perf_event_paranoid forbids it) - then available() is false.
+class CacheCounter {
+public:
+  CacheCounter() : descriptor(-1) {
+#ifdef __linux__
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    descriptor = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+  }
+  CacheCounter(const CacheCounter&) = delete;
+  CacheCounter& operator=(const CacheCounter&) = delete;
+  ~CacheCounter() {
+#ifdef __linux__
+    if (available()) {
+      close(descriptor);
+    }
+#endif
+  }
+
+  bool available() const {
+    return descriptor >= 0;
+  }
+
+  void start() {
+#ifdef __linux__
+    if (available()) {
+      ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // the misses since start
+  std::uint64_t stop() {
+    std::uint64_t count = 0;
+#ifdef __linux__
+    if (available()) {
+      ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(descriptor, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+      }
+    }
+#endif
+    return count;
+  }
+
+private:
+  long descriptor;
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "benchmark.hpp"
+#include "doubly_linked_list.hpp"
+#include "linked_list.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+
+// the same deque operations for the lists of this week and for the standard containers
+template <typename List>
+void push_front(List& list, int value) {
+  list.insert_first(value);
+}
+
+template <typename List>
+void push_back(List& list, int value) {
+  list.insert_last(value);
+}
+
+template <typename List>
+void pop_front(List& list) {
+  list.remove_first();
+}
+
+template <typename List>
+void pop_back(List& list) {
+  list.remove_last();
+}
+
+template <typename List>
+long long reverse_sum(const List& list) {
+  long long total = 0;
+  for (auto i = list.rbegin(); i != list.rend(); ++i) {
+    total += *i;
+  }
+  return total;
+}
+
+template <typename T>
+void push_front(std::deque<T>& deque, int value) {
+  deque.push_front(value);
+}
+
+template <typename T>
+void push_back(std::deque<T>& deque, int value) {
+  deque.push_back(value);
+}
+
+template <typename T>
+void pop_front(std::deque<T>& deque) {
+  deque.pop_front();
+}
+
+template <typename T>
+void pop_back(std::deque<T>& deque) {
+  deque.pop_back();
+}
+
+template <typename T>
+void push_front(std::list<T>& list, int value) {
+  list.push_front(value);
+}
+
+template <typename T>
+void push_back(std::list<T>& list, int value) {
+  list.push_back(value);
+}
+
+template <typename T>
+void pop_front(std::list<T>& list) {
+  list.pop_front();
+}
+
+template <typename T>
+void pop_back(std::list<T>& list) {
+  list.pop_back();
+}
+
+template <typename Container>
+void fill(Container& container, std::size_t depth) {
+  for (std::size_t i = 0; i < depth; ++i) {
+    push_back(container, int(i));
+  }
+}
+
+// enqueue at the front, dequeue at the back - the pattern that is quadratic with a singly linked list
+template <typename Container>
+double queue_from_the_back(std::size_t depth, std::size_t operations) {
+  Container container;
+  fill(container, depth);
+
+  return measure([&]() {
+    for (std::size_t i = 0; i < operations; i += 2) {
+      push_front(container, int(i));
+      pop_back(container);
+    }
+  });
+}
+
+template <typename Container>
+double stack_at_the_back(std::size_t depth, std::size_t operations) {
+  Container container;
+  fill(container, depth);
+
+  return measure([&]() {
+    for (std::size_t i = 0; i < operations; i += 2) {
+      push_back(container, int(i));
+      pop_back(container);
+    }
+  });
+}
+
+// random operations at both ends - below depth 3 of 4 operations insert and above it
+// 1 of 4, so the size is pulled back to depth and stays near it
+template <typename Container>
+double mixed(std::size_t depth, std::size_t operations) {
+  Container container;
+  fill(container, depth);
+  std::size_t size = depth;
+  std::mt19937 random(42);
+
+  return measure([&]() {
+    for (std::size_t i = 0; i < operations; ++i) {
+      unsigned choice = random();
+      bool insert = size == 0 || ((choice & 3) != 0) == (size < depth);
+
+      if (insert) {
+        choice & 4 ? push_front(container, int(i)) : push_back(container, int(i));
+        ++size;
+      } else {
+        choice & 4 ? pop_front(container) : pop_back(container);
+        --size;
+      }
+    }
+  });
+}
+
+template <typename Container>
+double reverse_iteration(std::size_t elements, long long& total) {
+  Container container;
+  fill(container, elements);
+
+  return measure([&]() {
+    total += reverse_sum(container);
+  });
+}
+
+template <typename Container>
+void report(const std::string& name, std::size_t depth, std::size_t operations, long long& total, bool quadratic = false) {
+  // the singly linked list walks the whole list on every removal at the back, so it gets fewer operations
+  std::size_t scaled = quadratic ? std::max<std::size_t>(operations / depth, 2) : operations;
+
+  std::cout << std::setw(20) << name << std::fixed << std::setprecision(1)
+            << std::setw(16) << queue_from_the_back<Container>(depth, scaled) * 1e6 / scaled
+            << std::setw(16) << stack_at_the_back<Container>(depth, scaled) * 1e6 / scaled
+            << std::setw(16) << mixed<Container>(depth, scaled) * 1e6 / scaled
+            << std::setw(16) << reverse_iteration<Container>(operations, total) * 1e6 / operations << '\n';
+}
+
+// usage: deque_benchmark [operations] [depth]
+int main(int argc, char* argv[]) {
+  std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::size_t depth = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+  long long total = 0;
+
+  std::cout << operations << " operations on " << depth << " elements, ns per operation"
+            << " (reverse iteration: ns per element of a list of " << operations << ")\n"
+            << std::setw(20) << "container" << std::setw(16) << "queue, back out"
+            << std::setw(16) << "stack at back" << std::setw(16) << "mixed" << std::setw(16) << "reverse" << '\n';
+
+  report<LinkedList<int>>("LinkedList", depth, operations, total, true);
+  report<DoublyLinkedList<int>>("DoublyLinkedList", depth, operations, total);
+  report<std::list<int>>("std::list", depth, operations, total);
+  report<std::deque<int>>("std::deque", depth, operations, total);
+
+  // keeps the sums from being optimized away
+  std::cout << "checksum " << total << '\n';
+
+  return 0;
+}
@@ -0,0 +1,288 @@
+#ifndef DOUBLY_LINKED_LIST_HPP
+#define DOUBLY_LINKED_LIST_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+// Doubly linked variant of LinkedList. Every node also points to the previous one,
+// so removing the last element or the element at an iterator is O(1) instead of a
+// walk from the first node, and the reverse iterator is just a node pointer.
+template <typename T>
+class DoublyLinkedList {
+public:
+  DoublyLinkedList() : first(nullptr), last(nullptr), size(0) {}
+  DoublyLinkedList(const DoublyLinkedList& other) : DoublyLinkedList() {
+    append(other);
+  }
+  DoublyLinkedList(DoublyLinkedList&& other)
+    : first(std::exchange(other.first, nullptr)),
+      last(std::exchange(other.last, nullptr)),
+      size(std::exchange(other.size, 0)) {}
+  ~DoublyLinkedList() {
+    while (!empty()) {
+      remove_first();
+    }
+  }
+  DoublyLinkedList<T>& operator=(const DoublyLinkedList& other) {
+    DoublyLinkedList<T> copy(other);
+    swap(copy);
+
+    return *this;
+  }
+  DoublyLinkedList<T>& operator=(DoublyLinkedList&& other) {
+    DoublyLinkedList<T> copy(std::move(other));
+    swap(copy);
+
+    return *this;
+  }
+
+  bool empty() const {
+    return !first;
+  }
+
+  std::size_t get_size() const {
+    return size;
+  }
+
+  void insert_first(const T& data) {
+    if (empty()) {
+      first = last = new Node(data);
+    } else {
+      first = first->prev = new Node(data, nullptr, first);
+    }
+
+    ++size;
+  }
+
+  void insert_last(const T& data) {
+    if (empty()) {
+      first = last = new Node(data);
+    } else {
+      last = last->next = new Node(data, last);
+    }
+
+    ++size;
+  }
+
+  void remove_first() {
+    unlink(first);
+  }
+
+  void remove_last() {
+    unlink(last);
+  }
+
+private:
+  struct Node;
+
+public:
+  class Iterator {
+  public:
+    Iterator(Node* const current) : current(current) {}
+
+    bool operator!=(const Iterator& other) const {
+      return current != other.current;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return !(*this != other);
+    }
+
+    Iterator& operator++() {
+      current = current->next;
+      return *this;
+    }
+
+    Iterator& operator--() {
+      current = current->prev;
+      return *this;
+    }
+
+    const T& operator*() const {
+      return current->data;
+    }
+
+    T& operator*() {
+      return current->data;
+    }
+
+  private:
+    friend class DoublyLinkedList<T>;
+
+    Node* current;
+  };
+
+  Iterator begin() const {
+    return Iterator(first);
+  }
+
+  Iterator end() const {
+    return Iterator(nullptr);
+  }
+
+  void insert_after(const T& data, const Iterator& position) {
+    Node* current = position.current;
+    if (current == last) {
+      insert_last(data);
+      return;
+    }
+
+    current->next = current->next->prev = new Node(data, current, current->next);
+    ++size;
+  }
+
+  void insert_before(const T& data, const Iterator& position) {
+    Node* current = position.current;
+    if (current == first) {
+      insert_first(data);
+      return;
+    }
+
+    current->prev = current->prev->next = new Node(data, current->prev, current);
+    ++size;
+  }
+
+  void remove_at(const Iterator& position) {
+    unlink(position.current);
+  }
+
+  void append(const DoublyLinkedList& other) {
+    for (Node* current = other.first; current; current = current->next) {
+      insert_last(current->data);
+    }
+  }
+
+  void unique() {
+    for (Node* current = first; current; current = current->next) {
+      Node* iter = current->next;
+
+      while (iter) {
+        Node* next = iter->next;
+        if (current->data == iter->data) {
+          unlink(iter);
+        }
+        iter = next;
+      }
+    }
+  }
+
+  void filter(const std::function<bool(const T&)>& predicate) {
+    Node* current = first;
+
+    while (current) {
+      Node* next = current->next;
+      if (!predicate(current->data)) {
+        unlink(current);
+      }
+      current = next;
+    }
+  }
+
+  void partition(const std::function<bool(const T&)>& predicate) {
+    Node *left_begin = nullptr, *left_end = nullptr, *right_begin = nullptr, *right_end = nullptr;
+
+    for (Node* iter = first; iter; iter = iter->next) {
+      bool left = predicate(iter->data);
+      Node*& begin = left ? left_begin : right_begin;
+      Node*& end = left ? left_end : right_end;
+
+      iter->prev = end;
+      if (!begin) {
+        begin = iter;
+      } else {
+        end->next = iter;
+      }
+      end = iter;
+    }
+
+    if (left_end) {
+      left_end->next = right_begin;
+    }
+    if (right_begin) {
+      right_begin->prev = left_end;
+    }
+    if (right_end) {
+      right_end->next = nullptr;
+    }
+    first = left_begin ? left_begin : right_begin;
+    last = right_end ? right_end : left_end;
+  }
+
+  // walks the prev pointers - no allocation, O(1) per step
+  class ReverseIterator {
+  public:
+    ReverseIterator(Node* const current) : current(current) {}
+
+    bool operator!=(const ReverseIterator& other) const {
+      return current != other.current;
+    }
+
+    bool operator==(const ReverseIterator& other) const {
+      return !(*this != other);
+    }
+
+    ReverseIterator& operator++() {
+      current = current->prev;
+      return *this;
+    }
+
+    T& operator*() {
+      return current->data;
+    }
+
+    const T& operator*() const {
+      return current->data;
+    }
+
+  private:
+    Node* current;
+  };
+
+  ReverseIterator rbegin() const {
+    return ReverseIterator(last);
+  }
+
+  ReverseIterator rend() const {
+    return ReverseIterator(nullptr);
+  }
+
+private:
+  struct Node {
+    T data;
+    Node *prev, *next;
+
+    Node(const T& data, Node* const prev = nullptr, Node* const next = nullptr)
+      : data(data), prev(prev), next(next) {}
+  };
+
+  Node *first, *last;
+  std::size_t size;
+
+  void swap(DoublyLinkedList& other) {
+    using std::swap;
+
+    swap(first, other.first);
+    swap(last, other.last);
+    swap(size, other.size);
+  }
+
+  void unlink(Node* node) {
+    if (node->prev) {
+      node->prev->next = node->next;
+    } else {
+      first = node->next;
+    }
+
+    if (node->next) {
+      node->next->prev = node->prev;
+    } else {
+      last = node->prev;
+    }
+
+    delete node;
+    --size;
+  }
+};
+
+#endif
@@ -1,17 +1,21 @@
 #ifndef LINKED_LIST_HPP
 #define LINKED_LIST_HPP
 
+#include "open_addressing_set.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <functional>
+#include <numeric>
 #include <stack>
 #include <utility>
+#include <vector>
 
 template <typename T>
 class LinkedList {
 public:  
   LinkedList() : first(nullptr), last(nullptr), size(0) {}
   LinkedList(const LinkedList& other)
-    : first(nullptr), last(nullptr), size(0) {
+    : first(nullptr), last(nullptr), size(other.size) {
     if (other.empty()) {
       return;
     }
@@ -159,6 +163,7 @@ public:
 
     Node* new_node = new Node(data, current->next);
     current->next = new_node;
+    ++size;
   }
 
   void remove_at(const Iterator& position) {
@@ -171,6 +176,7 @@ public:
       Node* prev = previous(current);
       prev->next = current->next;
       delete current;
+      --size;
     }
   }
 
@@ -182,6 +188,100 @@ public:
     }
   }
 
+  // takes over the nodes of other instead of copying them - O(1), other is left empty
+  void append(LinkedList&& other) {
+    if (other.empty()) {
+      return;
+    }
+
+    if (empty()) {
+      first = other.first;
+    } else {
+      last->next = other.first;
+    }
+    last = other.last;
+    size += other.size;
+
+    other.first = other.last = nullptr;
+    other.size = 0;
+  }
+
+  // moves the nodes of other after position - O(1), other is left empty
+  void splice_after(const Iterator& position, LinkedList&& other) {
+    if (other.empty()) {
+      return;
+    }
+
+    Node* current = position.current;
+    other.last->next = current->next;
+    current->next = other.first;
+    if (current == last) {
+      last = other.last;
+    }
+    size += other.size;
+
+    other.first = other.last = nullptr;
+    other.size = 0;
+  }
+
+  // Merges the sorted other into this sorted list by relinking the nodes, O(n + m).
+  // Stable - of equal elements the ones of this list come first. other is left empty.
+  template <typename Compare = std::less<T>>
+  void merge(LinkedList&& other, Compare compare = Compare()) {
+    if (other.empty()) {
+      return;
+    }
+
+    // the merge takes from this list until its last element, unless other ends with a smaller one
+    if (empty() || !compare(other.last->data, last->data)) {
+      last = other.last;
+    }
+    first = merge_nodes(first, other.first, compare);
+    size += other.size;
+
+    other.first = other.last = nullptr;
+    other.size = 0;
+  }
+
+  // Bottom-up merge sort that only relinks the next pointers - stable, O(n log n),
+  // no allocation. Sorted runs of 1, 2, 4, ... nodes wait in bins: every node starts a
+  // run of one, and while the bin for the size is taken the two runs are merged and
+  // carried to the next bin, as in adding one to a binary counter.
+  template <typename Compare = std::less<T>>
+  void sort(Compare compare = Compare()) {
+    // bin i holds 2^i nodes, 64 bins are enough for any list that fits in memory
+    Node* bins[64] = {};
+    std::size_t used = 0;
+
+    while (first) {
+      Node* run = first;
+      first = first->next;
+      run->next = nullptr;
+
+      std::size_t i = 0;
+      for (; bins[i]; ++i) {
+        // the bin holds earlier nodes, so it goes first for stability
+        run = merge_nodes(bins[i], run, compare);
+        bins[i] = nullptr;
+      }
+      bins[i] = run;
+      used = std::max(used, i + 1);
+    }
+
+    // the higher bins hold the earlier nodes
+    for (std::size_t i = 0; i < used; ++i) {
+      if (bins[i]) {
+        first = first ? merge_nodes(bins[i], first, compare) : bins[i];
+      }
+    }
+
+    last = first;
+    while (last && last->next) {
+      last = last->next;
+    }
+  }
+
+  // compares every element with all after it - O(n^2), but needs only operator==
   void unique() {
     Node* current = first;
 
@@ -195,6 +295,7 @@ public:
             last = prev;
           }
           delete iter;
+          --size;
           iter = prev->next;
         } else {
           iter = iter->next;
@@ -206,32 +307,86 @@ public:
     }
   }
 
-  void filter(const std::function<bool(const T&)>& predicate) {
-    while (!predicate(first->data)) {
-      remove_first();
+  // the same result in expected O(n): the first copies seen so far are kept in a hash set
+  template <typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+  void unique_by_hash(Hash hash = Hash(), Equal equal = Equal()) {
+    auto hash_node = [&hash](const Node* node) { return hash(node->data); };
+    auto equal_nodes = [&equal](const Node* left, const Node* right) { return equal(left->data, right->data); };
+    OpenAddressingSet<const Node*, decltype(hash_node), decltype(equal_nodes)> seen(size, hash_node, equal_nodes);
+
+    remove_nodes_if([&seen](const Node* node) {
+      return !seen.insert(node);
+    });
+  }
+
+  // the same result in O(n log n) for types that can be compared but not hashed: the
+  // positions are sorted stably by element, so in every run of equal elements the
+  // first one is the first copy in the list and the rest are removed
+  template <typename Less = std::less<T>>
+  void unique_by_sort(Less less = Less()) {
+    std::vector<const Node*> nodes;
+    for (const Node* current = first; current; current = current->next) {
+      nodes.push_back(current);
+    }
+
+    std::vector<std::size_t> order(nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&nodes, &less](std::size_t left, std::size_t right) {
+      return less(nodes[left]->data, nodes[right]->data);
+    });
+
+    std::vector<bool> duplicate(nodes.size(), false);
+    for (std::size_t i = 1; i < order.size(); ++i) {
+      duplicate[order[i]] = !less(nodes[order[i - 1]]->data, nodes[order[i]]->data);
     }
 
-    if (!first) {
-      last = nullptr;
+    std::size_t position = 0;
+    remove_nodes_if([&duplicate, &position](const Node*) {
+      return duplicate[position++];
+    });
+  }
+
+  // removes only the copies that directly follow each other - O(n), enough for sorted lists
+  void unique_adjacent() {
+    if (empty()) {
       return;
     }
 
-    Node *current = first->next, *prev = first;
-    while (current) {
-      if (!predicate(current->data)) {
-        prev->next = current->next;
-        delete current;
-        current = prev->next;
+    Node* current = first;
+    while (current->next) {
+      if (current->data == current->next->data) {
+        Node* duplicate = current->next;
+        current->next = duplicate->next;
+        if (duplicate == last) {
+          last = current;
+        }
+        delete duplicate;
+        --size;
       } else {
         current = current->next;
-        prev = prev->next;
       }
     }
+  }
 
-    last = prev;
+  // the std::function overloads call the predicate indirectly for every element; the
+  // template overloads below take lambdas directly, so the call can be inlined
+  void filter(const std::function<bool(const T&)>& predicate) {
+    filter<const std::function<bool(const T&)>&>(predicate);
   }
 
   void partition(const std::function<bool(const T&)>& predicate) {
+    partition<const std::function<bool(const T&)>&>(predicate);
+  }
+
+  template <typename Predicate>
+  void filter(Predicate predicate) {
+    remove_nodes_if([&predicate](const Node* node) {
+      return !predicate(node->data);
+    });
+  }
+
+  template <typename Predicate>
+  void partition(Predicate predicate) {
     Node *iter = first;
     Node *left_begin = nullptr, *left_end = nullptr, *right_begin = nullptr, *right_end = nullptr;
 
@@ -335,6 +490,53 @@ private:
 
     return iter;
   }
+
+  // merges two sorted chains into one, taking from left on ties
+  template <typename Compare>
+  static Node* merge_nodes(Node* left, Node* right, Compare& compare) {
+    Node* head = nullptr;
+    Node** tail = &head;
+
+    while (left && right) {
+      if (compare(right->data, left->data)) {
+        *tail = right;
+        right = right->next;
+      } else {
+        *tail = left;
+        left = left->next;
+      }
+      tail = &(*tail)->next;
+    }
+    *tail = left ? left : right;
+
+    return head;
+  }
+
+  // one pass in list order, deletes the nodes the predicate picks
+  template <typename Predicate>
+  void remove_nodes_if(Predicate remove) {
+    Node *prev = nullptr, *current = first;
+
+    while (current) {
+      Node* next = current->next;
+
+      if (remove(current)) {
+        if (prev) {
+          prev->next = next;
+        } else {
+          first = next;
+        }
+        delete current;
+        --size;
+      } else {
+        prev = current;
+      }
+
+      current = next;
+    }
+
+    last = prev;
+  }
   
   // ===========================================================
 };
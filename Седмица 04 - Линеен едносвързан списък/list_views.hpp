@@ -0,0 +1,190 @@
+#ifndef LIST_VIEWS_HPP
+#define LIST_VIEWS_HPP
+
+#include <cstddef>
+
+// Lazy views over anything with begin() and end(), such as the lists of this week.
+// A view keeps only iterators - building one allocates nothing and touches no element -
+// and the predicates and functions are template parameters, so the compiler inlines them.
+// Nested views run in one pass:
+//
+//   take_view(transform_view(filter_view(list, is_even), square), 10)
+//
+// walks the list once, squares only the even elements and stops at the tenth.
+// The views only read the elements and do not own them - the list must outlive the view.
+
+template <typename Iterator>
+class View {
+public:
+  View(const Iterator& first, const Iterator& last) : first(first), last(last) {}
+
+  Iterator begin() const {
+    return first;
+  }
+
+  Iterator end() const {
+    return last;
+  }
+
+private:
+  Iterator first, last;
+};
+
+// the iterators keep their predicate or function by value, so a view of a temporary view stays valid
+template <typename Iterator, typename Predicate>
+class FilterIterator {
+public:
+  FilterIterator(const Iterator& current, const Iterator& last, const Predicate& predicate)
+    : current(current), last(last), predicate(predicate) {
+    skip();
+  }
+
+  bool operator!=(const FilterIterator& other) const {
+    return current != other.current;
+  }
+
+  bool operator==(const FilterIterator& other) const {
+    return !(*this != other);
+  }
+
+  FilterIterator& operator++() {
+    ++current;
+    skip();
+    return *this;
+  }
+
+  decltype(auto) operator*() const {
+    return *current;
+  }
+
+private:
+  Iterator current, last;
+  Predicate predicate;
+
+  void skip() {
+    while (current != last && !predicate(*current)) {
+      ++current;
+    }
+  }
+};
+
+template <typename Iterator, typename Function>
+class TransformIterator {
+public:
+  TransformIterator(const Iterator& current, const Function& function)
+    : current(current), function(function) {}
+
+  bool operator!=(const TransformIterator& other) const {
+    return current != other.current;
+  }
+
+  bool operator==(const TransformIterator& other) const {
+    return !(*this != other);
+  }
+
+  TransformIterator& operator++() {
+    ++current;
+    return *this;
+  }
+
+  // called again on every dereference
+  auto operator*() const {
+    return function(*current);
+  }
+
+private:
+  Iterator current;
+  Function function;
+};
+
+// Ends when either the count or the elements run out. The end iterator has a count of 0.
+// After the last counted element the inner iterator is not advanced - stepping a filter
+// past it could walk the rest of the list for nothing.
+template <typename Iterator>
+class TakeIterator {
+public:
+  TakeIterator(const Iterator& current, std::size_t remaining)
+    : current(current), remaining(remaining) {}
+
+  bool operator!=(const TakeIterator& other) const {
+    return remaining != other.remaining && current != other.current;
+  }
+
+  bool operator==(const TakeIterator& other) const {
+    return !(*this != other);
+  }
+
+  TakeIterator& operator++() {
+    if (--remaining) {
+      ++current;
+    }
+    return *this;
+  }
+
+  decltype(auto) operator*() const {
+    return *current;
+  }
+
+private:
+  Iterator current;
+  std::size_t remaining;
+};
+
+// Every element is a view of the next size elements, the last one may be shorter.
+// Stepping to the next chunk walks the current one again, while its nodes are still in cache.
+template <typename Iterator>
+class ChunkIterator {
+public:
+  ChunkIterator(const Iterator& current, const Iterator& last, std::size_t size)
+    : current(current), last(last), size(size) {}
+
+  bool operator!=(const ChunkIterator& other) const {
+    return current != other.current;
+  }
+
+  bool operator==(const ChunkIterator& other) const {
+    return !(*this != other);
+  }
+
+  ChunkIterator& operator++() {
+    for (std::size_t i = 0; i < size && current != last; ++i) {
+      ++current;
+    }
+    return *this;
+  }
+
+  View<TakeIterator<Iterator>> operator*() const {
+    return View<TakeIterator<Iterator>>(TakeIterator<Iterator>(current, size), TakeIterator<Iterator>(last, 0));
+  }
+
+private:
+  Iterator current, last;
+  std::size_t size;
+};
+
+template <typename Range, typename Predicate>
+auto filter_view(const Range& range, Predicate predicate) {
+  using Filter = FilterIterator<decltype(range.begin()), Predicate>;
+  return View<Filter>(Filter(range.begin(), range.end(), predicate), Filter(range.end(), range.end(), predicate));
+}
+
+template <typename Range, typename Function>
+auto transform_view(const Range& range, Function function) {
+  using Transform = TransformIterator<decltype(range.begin()), Function>;
+  return View<Transform>(Transform(range.begin(), function), Transform(range.end(), function));
+}
+
+template <typename Range>
+auto take_view(const Range& range, std::size_t count) {
+  using Take = TakeIterator<decltype(range.begin())>;
+  return View<Take>(Take(range.begin(), count), Take(range.end(), 0));
+}
+
+// size must be positive
+template <typename Range>
+auto chunk_view(const Range& range, std::size_t size) {
+  using Chunk = ChunkIterator<decltype(range.begin())>;
+  return View<Chunk>(Chunk(range.begin(), range.end(), size), Chunk(range.end(), range.end(), size));
+}
+
+#endif
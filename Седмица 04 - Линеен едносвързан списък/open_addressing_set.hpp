@@ -0,0 +1,106 @@
+#ifndef OPEN_ADDRESSING_SET_HPP
+#define OPEN_ADDRESSING_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Hash set with linear probing in one flat array - a lookup is a few neighbouring
+// slots instead of a walk through a bucket list. The table is at most half full and
+// doubles when it would get fuller. Every slot keeps the scrambled hash of its key,
+// 0 marks an empty slot, and keys are only compared when the hashes match.
+// Keys must be default constructible; there is no removal.
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class OpenAddressingSet {
+public:
+  explicit OpenAddressingSet(std::size_t expected = 0, Hash hash = Hash(), Equal equal = Equal())
+    : hash(std::move(hash)), equal(std::move(equal)), count(0) {
+    std::size_t capacity = 16;
+    while (capacity < 2 * expected) {
+      capacity *= 2;
+    }
+    resize(capacity);
+  }
+
+  // false when an equal key is already in the set
+  bool insert(const Key& key) {
+    if (2 * (count + 1) > slots.size()) {
+      resize(2 * slots.size());
+    }
+
+    std::uint64_t code = scramble(key);
+    std::size_t i = find(key, code);
+    if (slots[i].code) {
+      return false;
+    }
+
+    slots[i] = {code, key};
+    ++count;
+    return true;
+  }
+
+  bool contains(const Key& key) const {
+    return slots[find(key, scramble(key))].code != 0;
+  }
+
+  std::size_t get_size() const {
+    return count;
+  }
+
+private:
+  struct Slot {
+    std::uint64_t code;
+    Key key;
+  };
+
+  std::vector<Slot> slots;
+  Hash hash;
+  Equal equal;
+  std::size_t count;
+  // the home slot is the top bits of the code
+  unsigned shift;
+
+  // Fibonacci hashing: the multiplication spreads hashes like the identity hash of
+  // small integers over all bits, and the top bits pick the slot
+  std::uint64_t scramble(const Key& key) const {
+    std::uint64_t code = std::uint64_t(hash(key)) * 0x9E3779B97F4A7C15ull;
+    return code ? code : 1;
+  }
+
+  // the slot with the key or the empty slot where it belongs
+  std::size_t find(const Key& key, std::uint64_t code) const {
+    std::size_t mask = slots.size() - 1;
+    std::size_t i = code >> shift;
+
+    while (slots[i].code && (slots[i].code != code || !equal(slots[i].key, key))) {
+      i = (i + 1) & mask;
+    }
+
+    return i;
+  }
+
+  void resize(std::size_t capacity) {
+    std::vector<Slot> old(capacity);
+    old.swap(slots);
+
+    shift = 64;
+    for (std::size_t size = capacity; size > 1; size /= 2) {
+      --shift;
+    }
+
+    std::size_t mask = capacity - 1;
+    for (Slot& slot : old) {
+      if (slot.code) {
+        std::size_t i = slot.code >> shift;
+        while (slots[i].code) {
+          i = (i + 1) & mask;
+        }
+        slots[i] = std::move(slot);
+      }
+    }
+  }
+};
+
+#endif
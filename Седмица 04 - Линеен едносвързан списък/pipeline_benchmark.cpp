@@ -0,0 +1,119 @@
+#include "benchmark.hpp"
+#include "linked_list.hpp"
+#include "list_views.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+LinkedList<int> random_list(std::size_t elements, std::mt19937& random) {
+  LinkedList<int> list;
+  for (std::size_t i = 0; i < elements; ++i) {
+    list.insert_last(int(random() % 1000));
+  }
+  return list;
+}
+
+void report(const std::string& name, double before, double after, std::size_t elements, bool correct) {
+  std::cout << std::setw(34) << name << std::fixed << std::setprecision(2)
+            << std::setw(12) << before * 1e6 / elements << std::setw(12) << after * 1e6 / elements
+            << (correct ? "" : "  WRONG") << '\n';
+}
+
+// usage: pipeline_benchmark [elements]
+int main(int argc, char* argv[]) {
+  std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::mt19937 random(42);
+  LinkedList<int> list = random_list(elements, random);
+
+  // the lambda stays the same, only the way it is passed changes
+  auto even = [](const int& value) { return value % 2 == 0; };
+  std::function<bool(const int&)> even_function = even;
+
+  std::cout << elements << " elements, ns per element\n"
+            << std::setw(34) << "operation" << std::setw(12) << "before" << std::setw(12) << "after" << '\n';
+
+  {
+    LinkedList<int> before = list, after = list;
+    double indirect = measure([&]() { before.filter(even_function); });
+    double inlined = measure([&]() { after.filter(even); });
+    report("filter in place", indirect, inlined, elements, before.get_size() == after.get_size());
+  }
+
+  {
+    LinkedList<int> before = list, after = list;
+    double indirect = measure([&]() { before.partition(even_function); });
+    double inlined = measure([&]() { after.partition(even); });
+    report("partition in place", indirect, inlined, elements, *before.begin() == *after.begin());
+  }
+
+  // filter -> square -> take half of the matches, summed
+  std::size_t count = elements / 4;
+  long long materialized = 0, fused = 0;
+
+  double before = measure([&]() {
+    LinkedList<int> filtered = list;
+    filtered.filter(even_function);
+
+    LinkedList<long long> squared;
+    for (int value : filtered) {
+      squared.insert_last((long long) value * value);
+    }
+
+    LinkedList<long long> taken;
+    auto position = squared.begin();
+    for (std::size_t i = 0; i < count && position != squared.end(); ++i, ++position) {
+      taken.insert_last(*position);
+    }
+
+    for (long long value : taken) {
+      materialized += value;
+    }
+  });
+
+  double after = measure([&]() {
+    auto square = [](const int& value) { return (long long) value * value; };
+    for (long long value : take_view(transform_view(filter_view(list, even), square), count)) {
+      fused += value;
+    }
+  });
+  report("filter, transform, take", before, after, elements, materialized == fused);
+
+  // the largest even element of every chunk of 64, summed
+  long long chunk_sums[2] = {0, 0};
+  before = measure([&]() {
+    LinkedList<int> filtered = list;
+    filtered.filter(even_function);
+
+    auto position = filtered.begin();
+    while (position != filtered.end()) {
+      LinkedList<int> chunk;
+      for (std::size_t i = 0; i < 64 && position != filtered.end(); ++i, ++position) {
+        chunk.insert_last(*position);
+      }
+
+      int largest = *chunk.begin();
+      for (int value : chunk) {
+        largest = std::max(largest, value);
+      }
+      chunk_sums[0] += largest;
+    }
+  });
+
+  after = measure([&]() {
+    for (auto chunk : chunk_view(filter_view(list, even), 64)) {
+      int largest = *chunk.begin();
+      for (int value : chunk) {
+        largest = std::max(largest, value);
+      }
+      chunk_sums[1] += largest;
+    }
+  });
+  report("filter, chunks of 64, maximum", before, after, elements, chunk_sums[0] == chunk_sums[1]);
+
+  return 0;
+}
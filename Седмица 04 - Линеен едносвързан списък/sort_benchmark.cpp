@@ -0,0 +1,94 @@
+#include "benchmark.hpp"
+#include "linked_list.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+LinkedList<int> to_list(const std::vector<int>& data) {
+  LinkedList<int> list;
+  for (int value : data) {
+    list.insert_last(value);
+  }
+  return list;
+}
+
+std::vector<int> to_vector(const LinkedList<int>& list) {
+  std::vector<int> result;
+  for (int value : list) {
+    result.push_back(value);
+  }
+  return result;
+}
+
+// the usual way to sort a singly linked list - copy out, sort the array, write back
+void sort_through_vector(LinkedList<int>& list) {
+  std::vector<int> values = to_vector(list);
+  std::stable_sort(values.begin(), values.end());
+
+  auto position = list.begin();
+  for (int value : values) {
+    *position = value;
+    ++position;
+  }
+}
+
+// usage: sort_benchmark [elements]
+int main(int argc, char* argv[]) {
+  std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::mt19937 random(42);
+
+  std::vector<int> shuffled(elements);
+  std::iota(shuffled.begin(), shuffled.end(), 0);
+  std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+  std::vector<int> sorted = shuffled;
+  std::sort(sorted.begin(), sorted.end());
+
+  std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+
+  std::cout << elements << " elements, milliseconds\n"
+            << std::setw(12) << "input" << std::setw(16) << "relinking sort" << std::setw(16) << "via vector" << '\n';
+
+  // shuffled last - sorting it scatters the order of the nodes in memory, and the freed nodes
+  // would hand the same scattered addresses to the next lists
+  for (const std::vector<int>* data : {&sorted, &reversed, &shuffled}) {
+    LinkedList<int> relinked = to_list(*data), copied = to_list(*data);
+    double relinking = measure([&]() { relinked.sort(); });
+    double through_vector = measure([&]() { sort_through_vector(copied); });
+    bool correct = to_vector(relinked) == sorted && to_vector(copied) == sorted;
+
+    const char* name = data == &shuffled ? "shuffled" : data == &sorted ? "sorted" : "reversed";
+    std::cout << std::setw(12) << name << std::fixed << std::setprecision(1)
+              << std::setw(16) << relinking << std::setw(16) << through_vector
+              << (correct ? "" : "  WRONG") << '\n';
+  }
+
+  // append of a list of the same length, once by copying the nodes and once by taking them over
+  LinkedList<int> target = to_list(shuffled), source = to_list(shuffled);
+  double copying = measure([&]() { target.append(source); });
+  double moving = measure([&]() { target.append(std::move(source)); });
+  bool consistent = target.get_size() == 3 * elements && source.empty();
+
+  std::cout << "\nappend " << elements << " elements, milliseconds\n"
+            << std::setw(12) << "copy" << std::setw(16) << copying << '\n'
+            << std::setw(12) << "move" << std::setw(16) << moving
+            << (consistent ? "" : "  WRONG") << '\n';
+
+  // merge of two sorted halves by relinking
+  std::vector<int> evens, odds;
+  for (int value : sorted) {
+    (value % 2 ? odds : evens).push_back(value);
+  }
+  LinkedList<int> left = to_list(evens), right = to_list(odds);
+  double merging = measure([&]() { left.merge(std::move(right)); });
+
+  std::cout << std::setw(12) << "merge" << std::setw(16) << merging
+            << (to_vector(left) == sorted && left.get_size() == elements ? "" : "  WRONG") << '\n';
+
+  return 0;
+}
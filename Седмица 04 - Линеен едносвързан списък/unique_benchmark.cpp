@@ -0,0 +1,95 @@
+#include "benchmark.hpp"
+#include "linked_list.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// elements of which the given fraction repeats earlier ones, in random order
+std::vector<int> generate(std::size_t elements, double duplicates, std::mt19937& random) {
+  std::size_t distinct = std::max<std::size_t>(1, elements - std::size_t(duplicates * elements));
+  std::vector<int> data(distinct);
+  std::iota(data.begin(), data.end(), 0);
+
+  std::uniform_int_distribution<int> repeat(0, distinct - 1);
+  while (data.size() < elements) {
+    data.push_back(repeat(random));
+  }
+
+  std::shuffle(data.begin(), data.end(), random);
+  return data;
+}
+
+LinkedList<int> to_list(const std::vector<int>& data) {
+  LinkedList<int> list;
+  for (int value : data) {
+    list.insert_last(value);
+  }
+  return list;
+}
+
+std::vector<int> to_vector(const LinkedList<int>& list) {
+  std::vector<int> result;
+  for (int value : list) {
+    result.push_back(value);
+  }
+  return result;
+}
+
+template <typename Function>
+double run(const std::vector<int>& data, Function function, std::vector<int>& result) {
+  LinkedList<int> list = to_list(data);
+  double time = measure([&]() {
+    function(list);
+  });
+
+  result = to_vector(list);
+  return time;
+}
+
+// usage: unique_benchmark [elements] [pairwise elements]
+int main(int argc, char* argv[]) {
+  std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  // the O(n^2) pairwise unique runs on a smaller list and is extrapolated
+  std::size_t pairwise_elements = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+  std::mt19937 random(42);
+
+  std::cout << elements << " elements, milliseconds; pairwise measured on " << pairwise_elements
+            << " elements and scaled by (n / " << pairwise_elements << ")^2\n"
+            << std::setw(12) << "duplicates" << std::setw(14) << "pairwise"
+            << std::setw(14) << "by hash" << std::setw(14) << "by sort" << std::setw(16) << "adjacent*" << '\n';
+
+  for (double duplicates : {0.0, 0.5, 0.9, 0.99}) {
+    std::vector<int> data = generate(elements, duplicates, random);
+    std::vector<int> small = generate(pairwise_elements, duplicates, random);
+    std::vector<int> by_hash, by_sort, expected, small_by_hash, adjacent;
+
+    double pairwise = run(small, [](LinkedList<int>& list) { list.unique(); }, expected);
+    run(small, [](LinkedList<int>& list) { list.unique_by_hash(); }, small_by_hash);
+    double scale = double(elements) / pairwise_elements;
+
+    double hash = run(data, [](LinkedList<int>& list) { list.unique_by_hash(); }, by_hash);
+    double sort = run(data, [](LinkedList<int>& list) { list.unique_by_sort(); }, by_sort);
+
+    // unique_adjacent only finds the copies that are next to each other, so it gets sorted input
+    std::vector<int> sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    double adjacent_time = run(sorted, [](LinkedList<int>& list) { list.unique_adjacent(); }, adjacent);
+
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    bool correct = small_by_hash == expected && by_sort == by_hash && adjacent == sorted && by_hash.size() == sorted.size();
+
+    std::cout << std::setw(11) << int(duplicates * 100) << '%' << std::fixed << std::setprecision(1)
+              << std::setw(14) << pairwise * scale * scale
+              << std::setw(14) << hash << std::setw(14) << sort << std::setw(16) << adjacent_time
+              << (correct ? "" : "  WRONG") << '\n';
+  }
+
+  std::cout << "* on the same elements sorted\n";
+  return 0;
+}
@@ -0,0 +1,474 @@
+#ifndef UNROLLED_LINKED_LIST_HPP
+#define UNROLLED_LINKED_LIST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stack>
+#include <utility>
+
+// the size of a node - two cache lines
+constexpr std::size_t UNROLLED_NODE_BYTES = 128;
+
+// Linked list that keeps a small array of elements in every node instead of a
+// single one, with the interface of LinkedList. Walking the list touches a new
+// node (and most likely misses the cache) once per array instead of once per
+// element, and there is one allocation and one pointer per array.
+// A full node is split in half on insertion and a node that falls below half
+// full is merged with the next one on removal, so the nodes stay at least half
+// full on average. Inserting or removing invalidates the iterators into the
+// nodes that were touched.
+template <typename T>
+class UnrolledLinkedList {
+  struct Node;
+
+public:
+  // elements in a node - as many as fit in UNROLLED_NODE_BYTES, but at least 4
+  static constexpr std::size_t NODE_CAPACITY = std::max<std::size_t>(4, (UNROLLED_NODE_BYTES - 2 * sizeof(void*)) / sizeof(T));
+
+  UnrolledLinkedList() : first(nullptr), last(nullptr), size(0) {}
+  UnrolledLinkedList(const UnrolledLinkedList& other) : UnrolledLinkedList() {
+    append(other);
+  }
+  UnrolledLinkedList(UnrolledLinkedList&& other)
+    : first(std::exchange(other.first, nullptr)),
+      last(std::exchange(other.last, nullptr)),
+      size(std::exchange(other.size, 0)) {}
+  ~UnrolledLinkedList() {
+    clear();
+  }
+  UnrolledLinkedList& operator=(const UnrolledLinkedList& other) {
+    UnrolledLinkedList copy(other);
+    swap(copy);
+
+    return *this;
+  }
+  UnrolledLinkedList& operator=(UnrolledLinkedList&& other) {
+    UnrolledLinkedList copy(std::move(other));
+    swap(copy);
+
+    return *this;
+  }
+
+  bool empty() const {
+    return !first;
+  }
+
+  std::size_t get_size() const {
+    return size;
+  }
+
+  void insert_first(const T& data) {
+    if (empty() || first->count == NODE_CAPACITY) {
+      Node* node = new Node(first);
+      first = node;
+      if (!last) {
+        last = node;
+      }
+    }
+
+    insert_into(first, 0, data);
+  }
+
+  void insert_last(const T& data) {
+    if (empty()) {
+      first = last = new Node();
+    } else if (last->count == NODE_CAPACITY) {
+      last = last->next = new Node();
+    }
+
+    insert_into(last, last->count, data);
+  }
+
+  void insert_last(T&& data) {
+    if (empty()) {
+      first = last = new Node();
+    } else if (last->count == NODE_CAPACITY) {
+      last = last->next = new Node();
+    }
+
+    new (last->items() + last->count) T(std::move(data));
+    ++last->count;
+    ++size;
+  }
+
+  void remove_first() {
+    erase(first, 0);
+  }
+
+  void remove_last() {
+    last->items()[--last->count].~T();
+    --size;
+
+    if (last->count == 0) {
+      unlink_last();
+    }
+  }
+
+  class Iterator {
+  public:
+    Iterator(Node* const current, std::size_t index = 0) : current(current), index(index) {}
+
+    bool operator!=(const Iterator& other) const {
+      return current != other.current || index != other.index;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return !(*this != other);
+    }
+
+    Iterator& operator++() {
+      if (++index == current->count) {
+        current = current->next;
+        index = 0;
+      }
+      return *this;
+    }
+
+    const T& operator*() const {
+      return current->items()[index];
+    }
+
+    T& operator*() {
+      return current->items()[index];
+    }
+
+  private:
+    friend class UnrolledLinkedList<T>;
+
+    Node* current;
+    std::size_t index;
+  };
+
+  Iterator begin() const {
+    return Iterator(first);
+  }
+
+  Iterator end() const {
+    return Iterator(nullptr);
+  }
+
+  void insert_after(const T& data, const Iterator& position) {
+    Node* node = position.current;
+    std::size_t index = position.index + 1;
+
+    if (node->count == NODE_CAPACITY) {
+      Node* right = split(node);
+      if (index > node->count) {
+        index -= node->count;
+        node = right;
+      }
+    }
+
+    insert_into(node, index, data);
+  }
+
+  void remove_at(const Iterator& position) {
+    erase(position.current, position.index);
+  }
+
+  void append(const UnrolledLinkedList& other) {
+    for (const T& data : other) {
+      insert_last(data);
+    }
+  }
+
+  // removes the later copies of every element, keeping the first ones in order - O(n^2)
+  void unique() {
+    for (Node* node = first; node; node = node->next) {
+      for (std::size_t i = 0; i < node->count; ++i) {
+        const T& data = node->items()[i];
+        remove_if_after(node, i, [&data](const T& other) { return other == data; });
+      }
+    }
+  }
+
+  // keeps only the elements that satisfy the predicate, packing them into as few nodes as possible
+  void filter(const std::function<bool(const T&)>& predicate) {
+    remove_if_after(nullptr, 0, [&predicate](const T& data) { return !predicate(data); });
+  }
+
+  // stable: the elements that satisfy the predicate go first, both parts keep their order
+  void partition(const std::function<bool(const T&)>& predicate) {
+    UnrolledLinkedList left, right;
+
+    while (first) {
+      Node* node = first;
+      for (std::size_t i = 0; i < node->count; ++i) {
+        T& data = node->items()[i];
+        (predicate(data) ? left : right).insert_last(std::move(data));
+        data.~T();
+      }
+
+      first = node->next;
+      delete node;
+    }
+
+    last = nullptr;
+    size = 0;
+
+    left.splice_back(right);
+    swap(left);
+  }
+
+  class ReverseIterator {
+  public:
+    ReverseIterator(Node* node) : index(0) {
+      while (node) {
+        stack.push(node);
+        node = node->next;
+      }
+
+      if (!stack.empty()) {
+        index = stack.top()->count - 1;
+      }
+    }
+
+    bool operator!=(const ReverseIterator& other) const {
+      if (stack.empty()) {
+        return !other.stack.empty();
+      }
+
+      return other.stack.empty() || stack.top() != other.stack.top() || index != other.index;
+    }
+
+    ReverseIterator& operator++() {
+      if (index > 0) {
+        --index;
+      } else {
+        stack.pop();
+        if (!stack.empty()) {
+          index = stack.top()->count - 1;
+        }
+      }
+      return *this;
+    }
+
+    T& operator*() {
+      return stack.top()->items()[index];
+    }
+
+    const T& operator*() const {
+      return stack.top()->items()[index];
+    }
+
+  private:
+    // a node per array, not per element
+    std::stack<Node*> stack;
+    std::size_t index;
+  };
+
+  ReverseIterator rbegin() const {
+    return ReverseIterator(first);
+  }
+
+  ReverseIterator rend() const {
+    return ReverseIterator(nullptr);
+  }
+
+private:
+  // the elements live in raw storage and are constructed and destroyed by the list
+  struct Node {
+    Node* next;
+    std::size_t count;
+    alignas(T) unsigned char storage[NODE_CAPACITY * sizeof(T)];
+
+    Node(Node* const next = nullptr) : next(next), count(0) {}
+
+    T* items() {
+      return std::launder(reinterpret_cast<T*>(storage));
+    }
+  };
+
+  Node *first, *last;
+  std::size_t size;
+
+  void swap(UnrolledLinkedList& other) {
+    using std::swap;
+
+    swap(first, other.first);
+    swap(last, other.last);
+    swap(size, other.size);
+  }
+
+  void clear() {
+    while (first) {
+      Node* next = first->next;
+      std::destroy_n(first->items(), first->count);
+      delete first;
+      first = next;
+    }
+
+    last = nullptr;
+    size = 0;
+  }
+
+  // moves the elements from index on one place to the right and constructs data at index
+  void insert_into(Node* node, std::size_t index, const T& data) {
+    T* items = node->items();
+
+    if (index == node->count) {
+      new (items + index) T(data);
+    } else {
+      T copy(data);
+      new (items + node->count) T(std::move(items[node->count - 1]));
+      std::move_backward(items + index, items + node->count - 1, items + node->count);
+      items[index] = std::move(copy);
+    }
+
+    ++node->count;
+    ++size;
+  }
+
+  // moves the second half of a full node to a new node after it
+  Node* split(Node* node) {
+    Node* right = new Node(node->next);
+    std::size_t half = node->count / 2;
+
+    std::uninitialized_move(node->items() + half, node->items() + node->count, right->items());
+    std::destroy(node->items() + half, node->items() + node->count);
+    right->count = node->count - half;
+    node->count = half;
+
+    node->next = right;
+    if (node == last) {
+      last = right;
+    }
+
+    return right;
+  }
+
+  // moves all of the next node into this one
+  void merge_next(Node* node) {
+    Node* next = node->next;
+
+    std::uninitialized_move(next->items(), next->items() + next->count, node->items() + node->count);
+    std::destroy_n(next->items(), next->count);
+    node->count += next->count;
+
+    node->next = next->next;
+    if (next == last) {
+      last = node;
+    }
+    delete next;
+  }
+
+  void erase(Node* node, std::size_t index) {
+    T* items = node->items();
+    std::move(items + index + 1, items + node->count, items + index);
+    items[--node->count].~T();
+    --size;
+
+    if (node->count == 0 && node == last) {
+      unlink_last();
+    } else if (node->count < NODE_CAPACITY / 2 && node->next && node->count + node->next->count <= NODE_CAPACITY) {
+      merge_next(node);
+    }
+  }
+
+  // the last node is empty
+  void unlink_last() {
+    if (first == last) {
+      delete first;
+      first = last = nullptr;
+    } else {
+      Node* prev = previous(last);
+      delete last;
+      last = prev;
+      last->next = nullptr;
+    }
+  }
+
+  // Removes the matching elements after the given position, or all matching elements
+  // when node is null, in one pass. The elements that stay are moved forward into the
+  // free places, so the nodes before the last one end up full and the rest are freed.
+  template <typename Remove>
+  void remove_if_after(Node* node, std::size_t index, Remove remove) {
+    if (empty()) {
+      return;
+    }
+
+    // the places between write and read hold no elements
+    Node *write = node ? node : first, *before_write = nullptr;
+    std::size_t position = node ? index + 1 : 0;
+    Node* read = write;
+    std::size_t from = position;
+
+    for (; read; read = read->next, from = 0) {
+      std::size_t count = read->count;
+
+      for (; from < count; ++from) {
+        T& data = read->items()[from];
+        if (remove(data)) {
+          data.~T();
+          --size;
+          continue;
+        }
+
+        if (position == NODE_CAPACITY) {
+          write->count = NODE_CAPACITY;
+          before_write = write;
+          write = write->next;
+          position = 0;
+        }
+
+        if (write != read || position != from) {
+          new (write->items() + position) T(std::move(data));
+          data.~T();
+        }
+        ++position;
+      }
+    }
+
+    for (Node* rest = write->next; rest;) {
+      Node* next = rest->next;
+      delete rest;
+      rest = next;
+    }
+
+    write->count = position;
+    write->next = nullptr;
+    last = write;
+
+    if (position == 0) {
+      delete write;
+      if (before_write) {
+        last = before_write;
+        last->next = nullptr;
+      } else {
+        first = last = nullptr;
+      }
+    }
+  }
+
+  Node* previous(Node* current) const {
+    Node* iter = first;
+    while (iter->next != current) {
+      iter = iter->next;
+    }
+
+    return iter;
+  }
+
+  // moves all nodes of other to the end of this list
+  void splice_back(UnrolledLinkedList& other) {
+    if (other.empty()) {
+      return;
+    }
+
+    if (empty()) {
+      first = other.first;
+    } else {
+      last->next = other.first;
+    }
+    last = other.last;
+    size += other.size;
+
+    other.first = other.last = nullptr;
+    other.size = 0;
+  }
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "benchmark.hpp"
+#include "cache_counter.hpp"
+#include "linked_list.hpp"
+#include "unrolled_linked_list.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Leaves the heap the way a long running program does: holes of the given size in
+// random order, so the next allocations of that size land all over the memory.
+// Every other block stays allocated until release, so the holes cannot merge.
+class AgedHeap {
+public:
+  AgedHeap(std::size_t block, std::size_t count, std::mt19937& random) {
+    std::vector<void*> holes;
+    for (std::size_t i = 0; i < count; ++i) {
+      holes.push_back(::operator new(block));
+      kept.push_back(::operator new(block));
+    }
+
+    std::shuffle(holes.begin(), holes.end(), random);
+    for (void* hole : holes) {
+      ::operator delete(hole);
+    }
+  }
+  AgedHeap(const AgedHeap&) = delete;
+  AgedHeap& operator=(const AgedHeap&) = delete;
+  ~AgedHeap() {
+    for (void* block : kept) {
+      ::operator delete(block);
+    }
+  }
+
+private:
+  std::vector<void*> kept;
+};
+
+CacheCounter counter;
+
+void report(const std::string& name, std::size_t elements, double time, std::uint64_t misses) {
+  std::cout << std::setw(36) << name << std::fixed << std::setprecision(2)
+            << std::setw(12) << time << "ms"
+            << std::setw(12) << time * 1e6 / elements << "ns";
+
+  if (counter.available()) {
+    std::cout << std::setw(14) << misses << std::setw(12) << double(misses) / elements;
+  } else {
+    std::cout << std::setw(14) << "n/a" << std::setw(12) << "n/a";
+  }
+  std::cout << '\n';
+}
+
+template <typename Function>
+void run(const std::string& name, std::size_t elements, Function function) {
+  counter.start();
+  double time = measure(function);
+  report(name, elements, time, counter.stop());
+}
+
+template <typename List>
+long long sum(const List& list) {
+  long long total = 0;
+  for (int value : list) {
+    total += value;
+  }
+  return total;
+}
+
+template <typename List>
+void benchmark(const std::string& name, std::size_t elements, long long& total) {
+  std::cout << '\n' << name << '\n';
+
+  {
+    List list;
+    run("insert_last", elements, [&]() {
+      for (std::size_t i = 0; i < elements; ++i) {
+        list.insert_last(int(i));
+      }
+    });
+    run("iterate", elements, [&]() { total += sum(list); });
+    run("filter, keep half", elements, [&]() {
+      list.filter([](const int& value) { return value % 2 == 0; });
+    });
+    run("iterate after filter", elements / 2, [&]() { total += sum(list); });
+  }
+
+  {
+    List list;
+    run("insert_first", elements, [&]() {
+      for (std::size_t i = 0; i < elements; ++i) {
+        list.insert_first(int(i));
+      }
+    });
+  }
+
+  {
+    List list;
+    list.insert_last(0);
+    run("insert_after the first element", elements, [&]() {
+      for (std::size_t i = 1; i < elements; ++i) {
+        list.insert_after(int(i), list.begin());
+      }
+    });
+    run("iterate after insert_after", elements, [&]() { total += sum(list); });
+  }
+}
+
+// the nodes are allocated into the holes of an aged heap
+template <typename List>
+void benchmark_aged(const std::string& name, std::size_t elements, std::size_t node_bytes, std::size_t nodes, std::mt19937& random, long long& total) {
+  std::cout << '\n' << name << ", aged heap\n";
+
+  AgedHeap heap(node_bytes, nodes, random);
+  List list;
+  run("insert_last", elements, [&]() {
+    for (std::size_t i = 0; i < elements; ++i) {
+      list.insert_last(int(i));
+    }
+  });
+  run("iterate", elements, [&]() { total += sum(list); });
+}
+
+// usage: unrolled_list_benchmark [elements]
+int main(int argc, char* argv[]) {
+  std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::mt19937 random(42);
+
+  std::cout << elements << " ints, " << UnrolledLinkedList<int>::NODE_CAPACITY << " per unrolled node"
+            << (counter.available() ? "" : ", no hardware counters - cache misses are not available") << '\n'
+            << std::setw(36) << "operation" << std::setw(14) << "total" << std::setw(14) << "per element"
+            << std::setw(14) << "cache misses" << std::setw(12) << "per element" << '\n';
+
+  long long total = 0;
+  benchmark<LinkedList<int>>("LinkedList", elements, total);
+  benchmark<UnrolledLinkedList<int>>("UnrolledLinkedList", elements, total);
+
+  // the aged heaps last - releasing one leaves the allocator slow for a while
+  // a LinkedList node is an int and a pointer
+  benchmark_aged<LinkedList<int>>("LinkedList", elements, 2 * sizeof(void*), elements, random, total);
+  benchmark_aged<UnrolledLinkedList<int>>("UnrolledLinkedList", elements, UNROLLED_NODE_BYTES, elements / UnrolledLinkedList<int>::NODE_CAPACITY + 1, random, total);
+
+  // keeps the sums from being optimized away
+  std::cout << "\nchecksum " << total << '\n';
+
+  return 0;
+}